@@ -0,0 +1,350 @@
+#pragma once
+
+// stand-ins for the CommonLibSSE and vcpkg types the benchmarked sources touch, so they build without the game SDK.
+// layouts and arithmetic follow CommonLibSSE closely enough for the timings to carry over, nothing else is modelled
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <cfloat>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <regex>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std::literals;
+
+namespace RE
+{
+	inline constexpr float NI_INFINITY{ FLT_MAX };
+	inline constexpr float NI_PI{ 3.1415927f };
+	inline constexpr float NI_TWO_PI{ 6.2831855f };
+
+	constexpr float deg_to_rad(float a_degrees) { return a_degrees * (NI_PI / 180.0f); }
+
+	struct NiPoint3
+	{
+		constexpr NiPoint3() = default;
+		constexpr NiPoint3(float a_x, float a_y, float a_z) :
+			x(a_x), y(a_y), z(a_z)
+		{}
+
+		constexpr NiPoint3 operator+(const NiPoint3& a_rhs) const { return { x + a_rhs.x, y + a_rhs.y, z + a_rhs.z }; }
+		constexpr NiPoint3 operator-(const NiPoint3& a_rhs) const { return { x - a_rhs.x, y - a_rhs.y, z - a_rhs.z }; }
+		constexpr NiPoint3 operator*(float a_scalar) const { return { x * a_scalar, y * a_scalar, z * a_scalar }; }
+		friend constexpr NiPoint3 operator*(float a_scalar, const NiPoint3& a_rhs) { return a_rhs * a_scalar; }
+		constexpr bool     operator==(const NiPoint3&) const = default;
+
+		// members
+		float x{ 0.0f };
+		float y{ 0.0f };
+		float z{ 0.0f };
+	};
+
+	struct NiColor
+	{
+		constexpr NiColor() = default;
+		constexpr NiColor(float a_red, float a_green, float a_blue) :
+			red(a_red), green(a_green), blue(a_blue)
+		{}
+
+		constexpr NiColor operator+(const NiColor& a_rhs) const { return { red + a_rhs.red, green + a_rhs.green, blue + a_rhs.blue }; }
+		constexpr NiColor operator-(const NiColor& a_rhs) const { return { red - a_rhs.red, green - a_rhs.green, blue - a_rhs.blue }; }
+		constexpr NiColor operator*(float a_scalar) const { return { red * a_scalar, green * a_scalar, blue * a_scalar }; }
+		friend constexpr NiColor operator*(float a_scalar, const NiColor& a_rhs) { return a_rhs * a_scalar; }
+		constexpr bool    operator==(const NiColor&) const = default;
+
+		// members
+		float red{ 0.0f };
+		float green{ 0.0f };
+		float blue{ 0.0f };
+	};
+
+	struct TESObjectREFR
+	{
+		std::uint32_t formID{ 0 };
+	};
+
+	struct ConditionCheckParams
+	{
+		ConditionCheckParams(TESObjectREFR* a_actionRef, TESObjectREFR* a_targetRef) :
+			actionRef(a_actionRef), targetRef(a_targetRef)
+		{}
+
+		// members
+		TESObjectREFR* actionRef;
+		TESObjectREFR* targetRef;
+	};
+
+	// same size and field order as CommonLibSSE, only what the evaluators read is named
+	struct CONDITION_ITEM_DATA
+	{
+		enum class OpCode : std::uint8_t
+		{
+			kEqualTo,
+			kNotEqualTo,
+			kGreaterThan,
+			kGreaterThanOrEqualTo,
+			kLessThan,
+			kLessThanOrEqualTo,
+		};
+
+		struct FLAGS
+		{
+			bool   isOR : 1;
+			bool   usesAliases : 1;
+			bool   global : 1;
+			bool   usePackData : 1;
+			bool   swapTarget : 1;
+			OpCode opCode : 3;
+		};
+
+		// members
+		union
+		{
+			float f;
+			void* g;
+		} comparisonValue{};
+		std::uint32_t runOnRef{ 0 };
+		std::uint32_t dataID{ 0 };
+		std::uint16_t function{ 0 };  // FUNCTION_DATA
+		void*         params[2]{};
+		FLAGS         flags{};
+		std::uint8_t  object{ 0 };
+	};
+
+	struct TESConditionItem
+	{
+		bool IsTrue(ConditionCheckParams& a_solution) const;  // out of line in main.cpp, it's an engine call
+
+		// members
+		TESConditionItem*   next{ nullptr };
+		CONDITION_ITEM_DATA data;
+	};
+
+	struct TESCondition
+	{
+		TESCondition() = default;
+		TESCondition(const TESCondition&) = delete;
+		~TESCondition()
+		{
+			while (head) {
+				delete std::exchange(head, head->next);
+			}
+		}
+
+		bool IsTrue(TESObjectREFR* a_actionRef, TESObjectREFR* a_targetRef) const;  // out of line in main.cpp, it's an engine call
+
+		// members
+		TESConditionItem* head{ nullptr };
+	};
+
+	struct NiQuaternion
+	{
+		float w{ 1.0f };
+		float x{ 0.0f };
+		float y{ 0.0f };
+		float z{ 0.0f };
+	};
+
+	struct NiMatrix3
+	{
+		// same convention as CommonLibSSE, R = Rx * Ry * Rz
+		void SetEulerAnglesXYZ(float a_x, float a_y, float a_z)
+		{
+			const float sinX = std::sin(a_x);
+			const float cosX = std::cos(a_x);
+			const float sinY = std::sin(a_y);
+			const float cosY = std::cos(a_y);
+			const float sinZ = std::sin(a_z);
+			const float cosZ = std::cos(a_z);
+
+			entry[0][0] = cosY * cosZ;
+			entry[0][1] = -cosY * sinZ;
+			entry[0][2] = sinY;
+			entry[1][0] = sinX * sinY * cosZ + cosX * sinZ;
+			entry[1][1] = cosX * cosZ - sinX * sinY * sinZ;
+			entry[1][2] = -sinX * cosY;
+			entry[2][0] = sinX * sinZ - cosX * sinY * cosZ;
+			entry[2][1] = cosX * sinY * sinZ + sinX * cosZ;
+			entry[2][2] = cosX * cosY;
+		}
+
+		// members
+		float entry[3][3]{};
+	};
+
+	struct NiTransform
+	{
+		NiMatrix3 rotate;
+		NiPoint3  translate;
+		float     scale{ 1.0f };
+	};
+
+	struct NiRefObject
+	{
+		void IncRefCount() { refCount.fetch_add(1); }
+		void DecRefCount() { refCount.fetch_sub(1); }  // the benchmark owns every object, nothing is deleted here
+
+		// members
+		std::atomic<std::uint32_t> refCount{ 0 };
+	};
+
+	struct NiNode : NiRefObject
+	{
+		NiTransform local;
+	};
+
+	struct NiPointLight : NiRefObject
+	{
+		void SetLightAttenuation(float a_radius) { invRadius = a_radius > 0.0f ? 1.0f / a_radius : 0.0f; }
+
+		// members
+		NiNode*  parent{ nullptr };
+		NiColor  diffuse;
+		NiPoint3 radius;
+		float    fade{ 1.0f };
+		float    invRadius{ 0.0f };
+	};
+
+	// intrusive pointer, copies cost an atomic increment and decrement like the real one
+	template <class T>
+	class NiPointer
+	{
+	public:
+		NiPointer() = default;
+		NiPointer(T* a_rhs) :
+			ptr(a_rhs)
+		{
+			TryAttach();
+		}
+		NiPointer(const NiPointer& a_rhs) :
+			ptr(a_rhs.ptr)
+		{
+			TryAttach();
+		}
+		~NiPointer() { TryDetach(); }
+
+		NiPointer& operator=(const NiPointer& a_rhs)
+		{
+			if (ptr != a_rhs.ptr) {
+				TryDetach();
+				ptr = a_rhs.ptr;
+				TryAttach();
+			}
+			return *this;
+		}
+
+		T* get() const { return ptr; }
+		T* operator->() const { return ptr; }
+		T& operator*() const { return *ptr; }
+
+		explicit operator bool() const { return ptr != nullptr; }
+
+	private:
+		void TryAttach()
+		{
+			if (ptr) {
+				ptr->IncRefCount();
+			}
+		}
+		void TryDetach()
+		{
+			if (ptr) {
+				ptr->DecRefCount();
+			}
+		}
+
+		// members
+		T* ptr{ nullptr };
+	};
+
+	inline constexpr NiPoint3 POINT_MAX{ NI_INFINITY, NI_INFINITY, NI_INFINITY };
+	inline constexpr NiColor  COLOR_MAX{ NI_INFINITY, NI_INFINITY, NI_INFINITY };
+
+	template <class T>
+	void UpdateNode(T*)
+	{}
+}
+
+namespace clib_util
+{
+	namespace string
+	{
+		// djb2, same as ClibUtil
+		constexpr std::uint32_t const_hash(std::string_view a_str)
+		{
+			std::uint32_t hash = 5381;
+			for (const auto ch : a_str) {
+				hash = hash * 33 + static_cast<std::uint32_t>(ch);
+			}
+			return hash;
+		}
+
+		namespace literals
+		{
+			constexpr std::uint32_t operator""_h(const char* a_str, std::size_t a_size)
+			{
+				return const_hash({ a_str, a_size });
+			}
+		}
+	}
+
+	class RNG
+	{
+	public:
+		float generate(float a_min, float a_max)
+		{
+			return std::uniform_real_distribution<float>(a_min, a_max)(engine);
+		}
+
+	private:
+		static inline thread_local std::mt19937 engine{ 0x4C50 };  // fixed seed, runs are repeatable
+	};
+}
+
+namespace string = clib_util::string;
+using namespace clib_util::string::literals;
+
+// Common.h, the real one is a case-insensitive boost::unordered_flat_map
+template <class D>
+using StringMap = std::unordered_map<std::string, D>;
+
+// the controller headers specialize glz::meta for the JSON reader, the benchmark never reads JSON
+namespace glz
+{
+	template <class T>
+	struct meta;
+
+	template <class... Args>
+	constexpr int enumerate(const Args&...)
+	{
+		return 0;
+	}
+
+	template <class... Args>
+	constexpr int object(const Args&...)
+	{
+		return 0;
+	}
+}
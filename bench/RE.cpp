@@ -0,0 +1,49 @@
+// engine functions the stand-ins in PCH.h call, kept in their own unit so the evaluators can't inline them
+
+namespace RE
+{
+	// a cheap deterministic result per function and subject, compared the way the engine compares
+	bool TESConditionItem::IsTrue(ConditionCheckParams& a_solution) const
+	{
+		const auto formID = a_solution.actionRef ? a_solution.actionRef->formID : 0;
+		const auto result = static_cast<float>(((data.function + 1) * 0x9E3779B1u ^ formID * 0x85EBCA77u) >> 29);
+
+		const auto value = data.comparisonValue.f;
+		switch (data.flags.opCode) {
+		case CONDITION_ITEM_DATA::OpCode::kEqualTo:
+			return result == value;
+		case CONDITION_ITEM_DATA::OpCode::kNotEqualTo:
+			return result != value;
+		case CONDITION_ITEM_DATA::OpCode::kGreaterThan:
+			return result > value;
+		case CONDITION_ITEM_DATA::OpCode::kGreaterThanOrEqualTo:
+			return result >= value;
+		case CONDITION_ITEM_DATA::OpCode::kLessThan:
+			return result < value;
+		default:
+			return result <= value;
+		}
+	}
+
+	// the engine's walk over the linked list: ORed items form a group, every group needs one true item
+	// the rest of a group is skipped once it is true, and the first false group ends the walk
+	bool TESCondition::IsTrue(TESObjectREFR* a_actionRef, TESObjectREFR* a_targetRef) const
+	{
+		ConditionCheckParams params(a_actionRef, a_targetRef);
+
+		bool groupTrue = false;
+		for (auto item = head; item; item = item->next) {
+			if (!groupTrue && item->IsTrue(params)) {
+				groupTrue = true;
+			}
+			if (!item->data.flags.isOR || !item->next) {
+				if (!groupTrue) {
+					return false;
+				}
+				groupTrue = false;
+			}
+		}
+
+		return true;
+	}
+}
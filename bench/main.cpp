@@ -0,0 +1,674 @@
+#include "CompiledCondition.h"
+#include "ConditionTokens.h"
+#include "LightControllers.h"
+#include "ModelTable.h"
+
+// micro benchmarks for the animation, attach and condition code, results are written to stdout as JSON
+// usage: LightPlacerBench [filter], only cases whose name contains the filter are run
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr std::uint64_t TARGET_OPS{ 2'000'000 };  // evaluations per case, split over frames
+	constexpr double        FRAME_TIME{ 1.0 / 60.0 };
+	constexpr std::size_t   BAKE_SAMPLES{ 256 };  // LIGH::LightSourceData::BAKE_SAMPLES
+
+	struct Result
+	{
+		std::string                                      name;
+		std::vector<std::pair<std::string, std::string>> params;
+		std::uint64_t                                    ops{ 0 };
+		double                                           nsPerOp{ 0.0 };
+	};
+
+	class Suite
+	{
+	public:
+		explicit Suite(std::string_view a_filter) :
+			filter(a_filter)
+		{}
+
+		bool ShouldRun(std::string_view a_name) const { return filter.empty() || a_name.find(filter) != std::string_view::npos; }
+
+		void Add(Result a_result) { results.push_back(std::move(a_result)); }
+
+		void Print() const
+		{
+			std::printf("{\n\t\"benchmarks\": [");
+			for (std::size_t i = 0; i < results.size(); ++i) {
+				const auto& result = results[i];
+				std::printf("%s\n\t\t{ \"name\": \"%s\"", i == 0 ? "" : ",", result.name.c_str());
+				for (const auto& [key, value] : result.params) {
+					std::printf(", \"%s\": \"%s\"", key.c_str(), value.c_str());
+				}
+				std::printf(", \"ops\": %llu, \"ns_per_op\": %.3f }", static_cast<unsigned long long>(result.ops), result.nsPerOp);
+			}
+			std::printf("\n\t],\n\t\"sink\": %g\n}\n", static_cast<double>(sink));
+		}
+
+		// members
+		float sink{ 0.0f };  // every evaluated value is folded in here so nothing is optimized away
+
+	private:
+		std::string         filter;
+		std::vector<Result> results;
+	};
+
+	template <class... Args>
+	std::string Format(const char* a_fmt, Args... a_args)
+	{
+		std::array<char, 256> buffer{};
+		const auto length = std::snprintf(buffer.data(), buffer.size(), a_fmt, a_args...);
+		return std::string(buffer.data(), static_cast<std::size_t>(std::clamp(length, 0, static_cast<int>(buffer.size()) - 1)));
+	}
+
+	std::mt19937& GetRNG()
+	{
+		static std::mt19937 rng{ 0x4C50 };
+		return rng;
+	}
+
+	float RandomFloat(float a_min, float a_max)
+	{
+		return std::uniform_real_distribution<float>(a_min, a_max)(GetRNG());
+	}
+
+	template <class T>
+	T RandomValue()
+	{
+		if constexpr (std::is_same_v<T, float>) {
+			return RandomFloat(0.0f, 512.0f);
+		} else if constexpr (std::is_same_v<T, RE::NiColor>) {
+			return { RandomFloat(0.0f, 1.0f), RandomFloat(0.0f, 1.0f), RandomFloat(0.0f, 1.0f) };
+		} else {
+			return { RandomFloat(-64.0f, 64.0f), RandomFloat(-64.0f, 64.0f), RandomFloat(-64.0f, 64.0f) };
+		}
+	}
+
+	template <class T>
+	float Fold(const T& a_value)
+	{
+		if constexpr (std::is_same_v<T, float>) {
+			return a_value;
+		} else if constexpr (std::is_same_v<T, RE::NiColor>) {
+			return a_value.red + a_value.green + a_value.blue;
+		} else {
+			return a_value.x + a_value.y + a_value.z;
+		}
+	}
+
+	const char* ToString(INTERPOLATION a_interpolation)
+	{
+		switch (a_interpolation) {
+		case INTERPOLATION::kStep:
+			return "step";
+		case INTERPOLATION::kLinear:
+			return "linear";
+		default:
+			return "cubic";
+		}
+	}
+
+	// keys are unevenly spaced so the cursor can't rely on a fixed stride
+	template <class T, std::uint32_t index = 0>
+	std::shared_ptr<KeyframeSequence<T, index>> MakeSequence(INTERPOLATION a_interpolation, std::size_t a_keyCount, bool a_bake)
+	{
+		auto sequence = std::make_shared<KeyframeSequence<T, index>>();
+		sequence->interpolation = a_interpolation;
+		sequence->keys.reserve(a_keyCount);
+
+		float time = 0.0f;
+		for (std::size_t i = 0; i < a_keyCount; ++i) {
+			sequence->keys.push_back({ time, RandomValue<T>(), 0.5f * RandomValue<T>(), 0.5f * RandomValue<T>() });
+			time += RandomFloat(0.05f, 0.5f);
+		}
+
+		sequence->Precompute();
+		if (a_bake) {
+			sequence->Bake(BAKE_SAMPLES);
+		}
+
+		return sequence;
+	}
+
+	// a_step returns how far the clock moves each frame
+	template <class F, class S>
+	double TimeFrames(std::uint64_t a_frames, F&& a_frame, S&& a_step)
+	{
+		double clock = 0.0;
+		a_frame(clock);  // warm up
+
+		const auto start = Clock::now();
+		for (std::uint64_t i = 0; i < a_frames; ++i) {
+			clock += a_step();
+			a_frame(clock);
+		}
+		return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	}
+
+	template <class F>
+	double TimeFrames(std::uint64_t a_frames, F&& a_frame)
+	{
+		return TimeFrames(a_frames, std::forward<F>(a_frame), [] { return FRAME_TIME; });
+	}
+
+	// a_jump moves the clock by a random fraction of the cycle each frame instead of one frame, as after a load or a long pause
+	template <class T>
+	void RunControllerCase(Suite& a_suite, const char* a_type, INTERPOLATION a_interpolation, std::size_t a_keyCount, bool a_randomStart, bool a_bake, std::size_t a_instances, bool a_jump = false)
+	{
+		const auto name = Format("controller/%s/%s/keys:%zu/%s/%s/n:%zu%s", a_type, ToString(a_interpolation), a_keyCount,
+			a_randomStart ? "random" : "sync", a_bake ? "baked" : "keyframed", a_instances, a_jump ? "/jump" : "");
+		if (!a_suite.ShouldRun(name)) {
+			return;
+		}
+
+		const std::shared_ptr<const KeyframeSequence<T>> sequence = MakeSequence<T>(a_interpolation, a_keyCount, a_bake);
+
+		std::vector<LightController<T>> controllers;
+		controllers.reserve(a_instances);
+		for (std::size_t i = 0; i < a_instances; ++i) {
+			controllers.emplace_back(sequence, a_randomStart);
+		}
+
+		const auto frames = std::max<std::uint64_t>(8, TARGET_OPS / a_instances);
+		const auto duration = sequence->GetDuration();
+		const auto elapsed = TimeFrames(
+			frames, [&](double a_clock) {
+				float sum = 0.0f;
+				for (auto& controller : controllers) {
+					sum += Fold(controller.GetValue(a_clock));
+				}
+				a_suite.sink += sum;
+			},
+			[&] { return a_jump ? static_cast<double>(RandomFloat(0.0f, duration)) : FRAME_TIME; });
+
+		const auto ops = frames * a_instances;
+		a_suite.Add({ name,
+			{ { "type", a_type },
+				{ "interpolation", ToString(a_interpolation) },
+				{ "keys", std::to_string(a_keyCount) },
+				{ "start", a_randomStart ? "random" : "sync" },
+				{ "baked", a_bake ? "true" : "false" },
+				{ "instances", std::to_string(a_instances) },
+				{ "clock", a_jump ? "jump" : "frame" } },
+			ops, elapsed / static_cast<double>(ops) });
+	}
+
+	template <class T>
+	void RunControllers(Suite& a_suite, const char* a_type)
+	{
+		for (const auto interpolation : { INTERPOLATION::kStep, INTERPOLATION::kLinear, INTERPOLATION::kCubic }) {
+			for (const auto bake : { false, true }) {
+				if (bake && interpolation == INTERPOLATION::kStep) {
+					continue;  // step curves are never baked
+				}
+				for (const std::size_t keyCount : { 4, 64, 1024 }) {
+					for (const auto randomStart : { false, true }) {
+						for (const std::size_t instances : { 1, 100, 10'000, 100'000 }) {
+							RunControllerCase<T>(a_suite, a_type, interpolation, keyCount, randomStart, bake, instances);
+						}
+					}
+				}
+			}
+		}
+
+		// segment lookups the cursor can't help with
+		for (const std::size_t keyCount : { 4, 64, 1024 }) {
+			RunControllerCase<T>(a_suite, a_type, INTERPOLATION::kLinear, keyCount, true, false, 10'000, true);
+		}
+	}
+}
+
+namespace
+{
+	// every light animates colour, radius and fade from shared cubic sequences, op is one light
+	void RunAnimationCase(Suite& a_suite, std::size_t a_lights)
+	{
+		const auto name = Format("animation/n:%zu", a_lights);
+		if (!a_suite.ShouldRun(name)) {
+			return;
+		}
+
+		const std::shared_ptr<const ColorKeyframeSequence> color = MakeSequence<RE::NiColor>(INTERPOLATION::kCubic, 16, false);
+		const std::shared_ptr<const FloatKeyframeSequence> radius = MakeSequence<float>(INTERPOLATION::kCubic, 16, false);
+		const std::shared_ptr<const FloatKeyframeSequence> fade = MakeSequence<float>(INTERPOLATION::kCubic, 16, false);
+
+		std::vector<RE::NiPointLight>                lights(a_lights);
+		std::vector<RE::NiPointer<RE::NiPointLight>> handles(lights.size());  // what LightOutput holds
+		std::vector<LightControllers>                controllers(lights.size());
+		for (std::size_t i = 0; i < lights.size(); ++i) {
+			handles[i] = RE::NiPointer(&lights[i]);
+			controllers[i].colorController.emplace(color, true);
+			controllers[i].radiusController.emplace(radius, true);
+			controllers[i].fadeController.emplace(fade, true);
+		}
+
+		const auto frames = std::max<std::uint64_t>(8, TARGET_OPS / a_lights);
+		const auto elapsed = TimeFrames(frames, [&](double a_clock) {
+			for (std::size_t i = 0; i < lights.size(); ++i) {
+				controllers[i].UpdateAnimation(handles[i], a_clock, 1.0f);
+			}
+			a_suite.sink += lights.front().fade + lights.back().invRadius;
+		});
+
+		const auto ops = frames * a_lights;
+		a_suite.Add({ name,
+			{ { "lights", std::to_string(a_lights) } },
+			ops, elapsed / static_cast<double>(ops) });
+	}
+
+	void RunAnimations(Suite& a_suite)
+	{
+		for (const std::size_t lights : { 1'000, 10'000 }) {
+			RunAnimationCase(a_suite, lights);
+		}
+	}
+}
+
+namespace
+{
+	// per light node write of UpdateAnimation, cubic curves stay on the Euler path and step/linear ones are converted to quaternions
+	void RunRotationCase(Suite& a_suite, INTERPOLATION a_interpolation, bool a_quaternion, bool a_bake, std::size_t a_keyCount, std::size_t a_instances)
+	{
+		const auto name = Format("rotation/%s/%s/keys:%zu/%s/n:%zu", a_quaternion ? "quaternion" : "euler", ToString(a_interpolation), a_keyCount,
+			a_bake ? "baked" : "keyframed", a_instances);
+		if (!a_suite.ShouldRun(name)) {
+			return;
+		}
+
+		const auto euler = MakeSequence<RE::NiPoint3, 1>(a_interpolation, a_keyCount, a_bake);
+		const auto quaternions = ConvertRotationSequence(*euler);
+
+		std::vector<RotationController>   eulerControllers;
+		std::vector<QuaternionController> quaternionControllers;
+		for (std::size_t i = 0; i < a_instances; ++i) {
+			if (a_quaternion) {
+				quaternionControllers.emplace_back(quaternions, true);
+			} else {
+				eulerControllers.emplace_back(euler, true);
+			}
+		}
+
+		std::vector<RE::NiNode> nodes(a_instances);
+
+		const auto frames = std::max<std::uint64_t>(8, TARGET_OPS / a_instances);
+		const auto elapsed = TimeFrames(frames, [&](double a_clock) {
+			for (std::size_t i = 0; i < a_instances; ++i) {
+				auto& rotate = nodes[i].local.rotate;
+				if (a_quaternion) {
+					RE::SetRotation(rotate, quaternionControllers[i].GetValue(a_clock));
+				} else {
+					auto rotation = eulerControllers[i].GetValue(a_clock);
+					RE::WrapRotation(rotation);
+					rotate.SetEulerAnglesXYZ(rotation.x, rotation.y, rotation.z);
+				}
+			}
+			a_suite.sink += nodes[0].local.rotate.entry[0][0] + nodes[a_instances - 1].local.rotate.entry[2][1];
+		});
+
+		const auto ops = frames * a_instances;
+		a_suite.Add({ name,
+			{ { "path", a_quaternion ? "quaternion" : "euler" },
+				{ "interpolation", ToString(a_interpolation) },
+				{ "keys", std::to_string(a_keyCount) },
+				{ "baked", a_bake ? "true" : "false" },
+				{ "instances", std::to_string(a_instances) } },
+			ops, elapsed / static_cast<double>(ops) });
+	}
+
+	void RunRotations(Suite& a_suite)
+	{
+		for (const std::size_t keyCount : { 8, 64 }) {
+			RunRotationCase(a_suite, INTERPOLATION::kLinear, false, false, keyCount, 10'000);
+			RunRotationCase(a_suite, INTERPOLATION::kLinear, false, true, keyCount, 10'000);
+			RunRotationCase(a_suite, INTERPOLATION::kLinear, true, false, keyCount, 10'000);
+			RunRotationCase(a_suite, INTERPOLATION::kCubic, false, false, keyCount, 10'000);
+			RunRotationCase(a_suite, INTERPOLATION::kCubic, false, true, keyCount, 10'000);
+		}
+	}
+}
+
+namespace
+{
+	// the lookup gameModels did before the table, hash_combine over lowercase chars and a case-insensitive compare
+	struct PathHash
+	{
+		std::size_t operator()(std::string_view a_path) const
+		{
+			std::size_t seed = 0;
+			for (const auto ch : a_path) {
+				seed ^= static_cast<std::size_t>(std::tolower(ch)) + 0x9E3779B9 + (seed << 6) + (seed >> 2);
+			}
+			return seed;
+		}
+	};
+
+	struct PathEqual
+	{
+		bool operator()(std::string_view a_lhs, std::string_view a_rhs) const
+		{
+			return std::ranges::equal(a_lhs, a_rhs, [](char a_l, char a_r) { return std::tolower(a_l) == std::tolower(a_r); });
+		}
+	};
+
+	std::string RandomModelPath(std::string_view a_folder)
+	{
+		static constexpr std::array names{ "candle"sv, "lantern"sv, "brazier"sv, "torch"sv, "chandelier"sv, "sconce"sv, "firepit"sv, "lamp"sv };
+		const auto name = names[GetRNG()() % names.size()];
+		return Format("Meshes\\%s\\%s%02u_%05u.nif", std::string(a_folder).c_str(), std::string(name).c_str(), static_cast<unsigned>(GetRNG()() % 100), static_cast<unsigned>(GetRNG()() % 100'000));
+	}
+
+	template <class F>
+	void RunModelCase(Suite& a_suite, const char* a_kind, std::size_t a_entries, std::uint32_t a_hitPercent, const std::vector<std::string>& a_queries, F&& a_find)
+	{
+		const auto name = Format("models/%s/entries:%zu/hits:%u%%", a_kind, a_entries, a_hitPercent);
+		if (!a_suite.ShouldRun(name)) {
+			return;
+		}
+
+		const auto frames = std::max<std::uint64_t>(8, TARGET_OPS / a_queries.size());
+		const auto elapsed = TimeFrames(frames, [&](double) {
+			std::size_t found = 0;
+			for (const auto& query : a_queries) {
+				found += a_find(query);
+			}
+			a_suite.sink += static_cast<float>(found);
+		});
+
+		const auto ops = frames * a_queries.size();
+		a_suite.Add({ name,
+			{ { "lookup", a_kind },
+				{ "entries", std::to_string(a_entries) },
+				{ "hits", std::to_string(a_hitPercent) } },
+			ops, elapsed / static_cast<double>(ops) });
+	}
+
+	// attach lookups for every loaded model, most of which have no lights
+	void RunModels(Suite& a_suite)
+	{
+		for (const std::size_t entryCount : { 1'000, 20'000 }) {
+			StringMap<ModelTable::Indices>                                      models;
+			std::unordered_map<std::string, ModelTable::Indices, PathHash, PathEqual> map;
+			std::vector<std::string>                                            paths;
+			while (models.size() < entryCount) {
+				auto path = RandomModelPath("lights");
+				if (models.emplace(path, ModelTable::Indices{ static_cast<std::uint32_t>(models.size()) }).second) {
+					map.emplace(path, ModelTable::Indices{ static_cast<std::uint32_t>(paths.size()) });
+					paths.push_back(std::move(path));
+				}
+			}
+
+			ModelTable table;
+			table.Build(models);
+
+			for (const std::uint32_t hitPercent : { 0u, 5u, 100u }) {
+				std::vector<std::string> queries;
+				queries.reserve(10'000);
+				for (std::size_t i = 0; i < 10'000; ++i) {
+					if (GetRNG()() % 100 < hitPercent) {
+						queries.push_back(paths[GetRNG()() % paths.size()]);
+					} else {
+						queries.push_back(RandomModelPath(i % 2 ? "clutter" : "lights"));  // half share the folder and name pattern
+					}
+				}
+
+				RunModelCase(a_suite, "table", entryCount, hitPercent, queries, [&](const std::string& a_path) {
+					return table.Find(a_path) != nullptr;
+				});
+				RunModelCase(a_suite, "map", entryCount, hitPercent, queries, [&](const std::string& a_path) {
+					return map.find(a_path) != map.end();
+				});
+			}
+		}
+	}
+}
+
+namespace
+{
+	// condition strings as configs write them, with the odd spacing and both list separators. params are editorIDs, the grammar has no plugin-qualified forms
+	std::string RandomCondition()
+	{
+		static constexpr std::array subjects{ "Self "sv, "PlayerRef "sv, "CombatTarget "sv };
+		static constexpr std::array functions{ "GetIsID"sv, "IsInInterior"sv, "GetInCurrentLoc"sv, "GetGlobalValue"sv, "GetCurrentTime"sv, "IsPCSleeping"sv, "GetQuestCompleted"sv, "GetDistance"sv };
+		static constexpr std::array ops{ "=="sv, "!="sv, ">"sv, ">="sv, "<"sv, "<="sv };
+		static constexpr std::array separators{ ""sv, " AND"sv, " OR"sv };
+
+		auto& rng = GetRNG();
+		auto  condition = Format("%s%s %s", std::string(subjects[rng() % subjects.size()]).c_str(), std::string(functions[rng() % functions.size()]).c_str(),
+			 rng() % 2 ? Format("LP_Form%04u", static_cast<unsigned>(rng() % 10'000)).c_str() : "NONE");
+		if (rng() % 4 == 0) {
+			condition += " NONE";
+		}
+		condition += Format("%s%s %.2f%s", rng() % 2 ? " " : "", std::string(ops[rng() % ops.size()]).c_str(), RandomFloat(0.0f, 1024.0f), std::string(separators[rng() % separators.size()]).c_str());
+		return condition;
+	}
+
+	template <class F>
+	void RunConditionCase(Suite& a_suite, const char* a_parser, const std::vector<std::string>& a_corpus, F&& a_parse)
+	{
+		const auto name = Format("conditions/%s/n:%zu", a_parser, a_corpus.size());
+		if (!a_suite.ShouldRun(name)) {
+			return;
+		}
+
+		const auto frames = std::max<std::uint64_t>(8, TARGET_OPS / 4 / a_corpus.size());
+		const auto elapsed = TimeFrames(frames, [&](double) {
+			float sum = 0.0f;
+			for (const auto& condition : a_corpus) {
+				sum += a_parse(condition);
+			}
+			a_suite.sink += sum;
+		});
+
+		const auto ops = frames * a_corpus.size();
+		a_suite.Add({ name,
+			{ { "parser", a_parser },
+				{ "conditions", std::to_string(a_corpus.size()) } },
+			ops, elapsed / static_cast<double>(ops) });
+	}
+
+	RE::CONDITION_ITEM_DATA RandomConditionData(bool a_isOR)
+	{
+		auto& rng = GetRNG();
+
+		RE::CONDITION_ITEM_DATA data{};
+		data.function = static_cast<std::uint16_t>(rng() % 800);
+		data.comparisonValue.f = static_cast<float>(rng() % 8);
+		data.flags.opCode = static_cast<OP_CODE>(rng() % 6);
+		data.flags.isOR = a_isOR;
+		return data;
+	}
+
+	// the append BuildCondition did before it kept the tail
+	void AppendByWalking(RE::TESCondition& a_condition, const RE::CONDITION_ITEM_DATA& a_data)
+	{
+		auto newNode = new RE::TESConditionItem;
+		newNode->data = a_data;
+
+		if (!a_condition.head) {
+			a_condition.head = newNode;
+			return;
+		}
+		auto current = a_condition.head;
+		while (current->next) {
+			current = current->next;
+		}
+		current->next = newNode;
+	}
+
+	// lists are grown round-robin with unrelated allocations in between, so their nodes end up scattered like the game's
+	std::vector<std::unique_ptr<RE::TESCondition>> MakeConditionLists(std::size_t a_count, std::size_t a_items)
+	{
+		std::vector<std::unique_ptr<RE::TESCondition>> lists(a_count);
+		for (auto& list : lists) {
+			list = std::make_unique<RE::TESCondition>();
+		}
+
+		std::vector<std::unique_ptr<char[]>> churn;
+		for (std::size_t item = 0; item < a_items; ++item) {
+			for (auto& list : lists) {
+				AppendByWalking(*list, RandomConditionData(item + 1 < a_items && GetRNG()() % 3 == 0));
+				churn.push_back(std::make_unique<char[]>(16 + GetRNG()() % 112));
+			}
+		}
+		return lists;
+	}
+
+	// a whole list evaluated per op, subjects rotate so results vary between lights
+	void RunConditionEvalCases(Suite& a_suite, std::size_t a_items)
+	{
+		const auto listName = Format("conditions/eval/list/items:%zu/n:10000", a_items);
+		const auto flatName = Format("conditions/eval/flat/items:%zu/n:10000", a_items);
+		if (!a_suite.ShouldRun(listName) && !a_suite.ShouldRun(flatName)) {
+			return;
+		}
+
+		const auto lists = MakeConditionLists(10'000, a_items);
+
+		std::vector<CompiledCondition> compiled;
+		compiled.reserve(lists.size());
+		for (const auto& list : lists) {
+			compiled.emplace_back(*list);
+		}
+
+		std::vector<RE::TESObjectREFR> refs(64);
+		for (std::size_t i = 0; i < refs.size(); ++i) {
+			refs[i].formID = static_cast<std::uint32_t>(0xFF000800 + i);
+		}
+
+		// both evaluators must agree on every list and subject
+		std::size_t mismatches = 0;
+		for (std::size_t i = 0; i < lists.size(); ++i) {
+			for (auto& ref : refs) {
+				mismatches += lists[i]->IsTrue(&ref, nullptr) != compiled[i].IsTrue(&ref, nullptr);
+			}
+		}
+
+		const auto run = [&](const std::string& a_name, const char* a_kind, auto&& a_isTrue) {
+			if (!a_suite.ShouldRun(a_name)) {
+				return;
+			}
+
+			const auto frames = std::max<std::uint64_t>(8, TARGET_OPS / lists.size());
+			const auto elapsed = TimeFrames(frames, [&](double) {
+				std::size_t trueCount = 0;
+				for (std::size_t i = 0; i < lists.size(); ++i) {
+					trueCount += a_isTrue(i, &refs[i % refs.size()]);
+				}
+				a_suite.sink += static_cast<float>(trueCount);
+			});
+
+			const auto ops = frames * lists.size();
+			a_suite.Add({ a_name,
+				{ { "evaluator", a_kind },
+					{ "items", std::to_string(a_items) },
+					{ "mismatches", std::to_string(mismatches) } },
+				ops, elapsed / static_cast<double>(ops) });
+		};
+
+		run(listName, "list", [&](std::size_t a_index, RE::TESObjectREFR* a_ref) { return lists[a_index]->IsTrue(a_ref, nullptr); });
+		run(flatName, "flat", [&](std::size_t a_index, RE::TESObjectREFR* a_ref) { return compiled[a_index].IsTrue(a_ref, nullptr); });
+	}
+
+	// one list built per op, appending by walking from the head against keeping the tail and flattening
+	void RunConditionBuildCases(Suite& a_suite, std::size_t a_items)
+	{
+		std::vector<RE::CONDITION_ITEM_DATA> data;
+		for (std::size_t i = 0; i < a_items; ++i) {
+			data.push_back(RandomConditionData(i + 1 < a_items && GetRNG()() % 3 == 0));
+		}
+
+		const auto run = [&](const char* a_kind, auto&& a_build) {
+			const auto name = Format("conditions/build/%s/items:%zu", a_kind, a_items);
+			if (!a_suite.ShouldRun(name)) {
+				return;
+			}
+
+			const auto frames = std::max<std::uint64_t>(8, TARGET_OPS / 8 / a_items);
+			const auto elapsed = TimeFrames(frames, [&](double) {
+				a_suite.sink += static_cast<float>(a_build());
+			});
+
+			a_suite.Add({ name,
+				{ { "build", a_kind },
+					{ "items", std::to_string(a_items) } },
+				frames, elapsed / static_cast<double>(frames) });
+		};
+
+		run("walk", [&] {
+			RE::TESCondition condition;
+			for (const auto& item : data) {
+				AppendByWalking(condition, item);
+			}
+			return condition.head != nullptr;
+		});
+		run("tail", [&] {
+			RE::TESCondition       condition;
+			RE::TESConditionItem* tail = nullptr;
+			for (const auto& item : data) {
+				auto newNode = new RE::TESConditionItem;
+				newNode->data = item;
+				(tail ? tail->next : condition.head) = newNode;
+				tail = newNode;
+			}
+			return CompiledCondition(condition).size();
+		});
+	}
+
+	// BuildCondition's syntax pass. the regex case is the pattern and sub-match copies the tokenizer replaced,
+	// run through std::regex since srell isn't available outside vcpkg; both are ECMAScript backtracking engines
+	void RunConditions(Suite& a_suite)
+	{
+		std::vector<std::string> corpus;
+		corpus.reserve(10'000);
+		for (std::size_t i = 0; i < 10'000; ++i) {
+			corpus.push_back(RandomCondition());
+		}
+
+		RunConditionCase(a_suite, "tokenizer", corpus, [](const std::string& a_condition) {
+			const auto tokens = ConditionTokens::Tokenize(a_condition);
+			return tokens ? tokens->value + static_cast<float>(tokens->function.size() + tokens->param1.size()) : 0.0f;
+		});
+
+		const std::regex condRegex{ R"((\w+)?\s*(\w+)\s+(\w+)(?:\s+(\w+))?\s*([=!<>]+)\s*([\d.]+)\s*(AND|OR)?)" };
+		RunConditionCase(a_suite, "regex", corpus, [&](const std::string& a_condition) {
+			std::cmatch match;
+			if (!std::regex_match(a_condition.c_str(), match, condRegex)) {
+				return 0.0f;
+			}
+			const auto subject = match[1].str();
+			const auto function = match[2].str();
+			const auto param1 = match[3].str();
+			const auto param2 = match[4].str();
+			const auto opCode = string::const_hash(match[5].str());
+			const auto value = std::strtof(match[6].str().c_str(), nullptr);
+			const auto isOR = match[7].str() == "OR";
+			return value + static_cast<float>(subject.size() + function.size() + param1.size() + param2.size() + opCode % 2 + isOR);
+		});
+
+		for (const std::size_t items : { 2, 4, 8 }) {
+			RunConditionEvalCases(a_suite, items);
+		}
+		for (const std::size_t items : { 4, 16, 64 }) {
+			RunConditionBuildCases(a_suite, items);
+		}
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	Suite suite(a_argc > 1 ? a_argv[1] : "");
+
+	RunControllers<float>(suite, "float");
+	RunControllers<RE::NiColor>(suite, "color");
+	RunControllers<RE::NiPoint3>(suite, "point");
+	RunAnimations(suite);
+	RunRotations(suite);
+	RunModels(suite);
+	RunConditions(suite);
+
+	suite.Print();
+
+	return 0;
+}
@@ -1,6 +1,9 @@
 set(headers ${headers}
 	src/Common.h
+	src/CompiledCondition.h
 	src/ConditionParser.h
+	src/ConditionTokens.h
+	src/ConfigCache.h
 	src/ConfigData.h
 	src/Debug.h
 	src/Hooks.h
@@ -10,11 +13,14 @@ set(headers ${headers}
 	src/Hooks/Update.h
 	src/LightControllers.h
 	src/LightData.h
+	src/LoadReport.h
 	src/Manager.h
+	src/ModelTable.h
 	src/PCH.h
 	src/Papyrus.h
 	src/ProcessedLights.h
 	src/RE.h
+	src/Rotation.h
 	src/Settings.h
 	src/SourceData.h
 )
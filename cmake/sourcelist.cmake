@@ -1,5 +1,9 @@
 set(sources ${sources}
+	src/CompiledCondition.cpp
+	src/ConditionFunctions.cpp
 	src/ConditionParser.cpp
+	src/ConditionTokens.cpp
+	src/ConfigCache.cpp
 	src/ConfigData.cpp
 	src/Debug.cpp
 	src/Hooks.cpp
@@ -9,11 +13,14 @@ set(sources ${sources}
 	src/Hooks/Update.cpp
 	src/LightControllers.cpp
 	src/LightData.cpp
+	src/LoadReport.cpp
 	src/Manager.cpp
+	src/ModelTable.cpp
 	src/PCH.cpp
 	src/Papyrus.cpp
 	src/ProcessedLights.cpp
 	src/RE.cpp
+	src/Rotation.cpp
 	src/Settings.cpp
 	src/SourceData.cpp
 	src/main.cpp
@@ -0,0 +1,39 @@
+#include "CompiledCondition.h"
+
+CompiledCondition::CompiledCondition(const RE::TESCondition& a_condition, bool a_subjectIndependent) :
+	subjectIndependent(a_subjectIndependent)
+{
+	std::size_t count = 0;
+	for (auto item = a_condition.head; item; item = item->next) {
+		++count;
+	}
+	items.reserve(count);
+
+	for (auto item = a_condition.head; item; item = item->next) {
+		auto& copy = items.emplace_back(*item);
+		copy.next = nullptr;
+	}
+
+	// an OR item is ORed with the next one, so the last item always closes its group
+	if (!items.empty()) {
+		items.back().data.flags.isOR = false;
+	}
+}
+
+bool CompiledCondition::IsTrue(RE::TESObjectREFR* a_subject, RE::TESObjectREFR* a_target) const
+{
+	RE::ConditionCheckParams params(a_subject, a_target);
+
+	// every group ends at an AND item. a true item skips to that item, a false AND item means no item in its group was true
+	for (auto it = items.begin(); it != items.end(); ++it) {
+		if (it->IsTrue(params)) {
+			while (it->data.flags.isOR) {
+				++it;
+			}
+		} else if (!it->data.flags.isOR) {
+			return false;
+		}
+	}
+
+	return true;
+}
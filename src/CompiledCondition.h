@@ -0,0 +1,23 @@
+#pragma once
+
+// flattened TESCondition, items are stored contiguously and OR groups are closed at build time
+// a list is true when every group has at least one true item, same as TESCondition::IsTrue
+class CompiledCondition
+{
+public:
+	CompiledCondition() = default;
+	explicit CompiledCondition(const RE::TESCondition& a_condition, bool a_subjectIndependent = false);
+
+	bool IsTrue(RE::TESObjectREFR* a_subject, RE::TESObjectREFR* a_target) const;
+	bool IsSubjectIndependent() const { return subjectIndependent; }  // same result on every ref
+
+	std::span<const RE::TESConditionItem> GetItems() const { return items; }
+
+	std::size_t size() const { return items.size(); }
+	bool        empty() const { return items.empty(); }
+
+private:
+	// members
+	std::vector<RE::TESConditionItem> items;  // next pointers are cleared, the last item is never OR
+	bool                              subjectIndependent{ false };
+};
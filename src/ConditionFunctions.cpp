@@ -0,0 +1,10 @@
+#include "ConditionFunctions.h"
+
+std::expected<ConditionTokens, ConditionTokens::Error> ConditionFunctions::Validate(std::string_view a_condition)
+{
+	auto tokens = ConditionTokens::Tokenize(a_condition);
+	if (tokens && funcIDs.find(tokens->function) == funcIDs.end()) {
+		return std::unexpected(ConditionTokens::Error{ static_cast<std::size_t>(tokens->function.data() - a_condition.data()) + 1, "unknown function" });
+	}
+	return tokens;
+}
@@ -1,4 +1,5 @@
 #include "ConditionParser.h"
+#include "LoadReport.h"
 
 PARAMS ConditionParser::GetFuncType(FUNC_ID a_funcID)
 {
@@ -558,6 +559,220 @@ PARAMS ConditionParser::GetFuncType(FUNC_ID a_funcID)
 	return paramPair;
 }
 
+CONDITION_INPUT ConditionParser::GetFuncInputs(FUNC_ID a_funcID)
+{
+	switch (a_funcID) {
+	case FUNC_ID::kGetIsID:
+	case FUNC_ID::kGetIsReference:
+	case FUNC_ID::kGetIsRace:
+	case FUNC_ID::kGetIsSex:
+	case FUNC_ID::kGetIsPlayableRace:
+	case FUNC_ID::kGetIsClass:
+	case FUNC_ID::kGetIsCreature:
+	case FUNC_ID::kGetIsObjectType:
+	case FUNC_ID::kGetIsVoiceType:
+	case FUNC_ID::kGetIsEditorLocation:
+	case FUNC_ID::kGetStartingPos:
+	case FUNC_ID::kGetStartingAngle:
+	case FUNC_ID::kHasRefType:
+	case FUNC_ID::kIsChild:
+	case FUNC_ID::kIsUnique:
+	case FUNC_ID::kIsXBox:
+	case FUNC_ID::kIsPS3:
+	case FUNC_ID::kIsWin32:
+		return CONDITION_INPUT::None;
+	case FUNC_ID::kGetCurrentTime:
+	case FUNC_ID::kGetDayOfWeek:
+	case FUNC_ID::kGetTimeDead:
+		return CONDITION_INPUT::GameHour;
+	case FUNC_ID::kIsRaining:
+	case FUNC_ID::kIsSnowing:
+	case FUNC_ID::kIsPleasant:
+	case FUNC_ID::kIsCloudy:
+	case FUNC_ID::kGetIsCurrentWeather:
+	case FUNC_ID::kGetCurrentWeatherPercent:
+	case FUNC_ID::kGetWindSpeed:
+		return CONDITION_INPUT::Weather;
+	case FUNC_ID::kGetInCell:
+	case FUNC_ID::kGetInCurrentLoc:
+	case FUNC_ID::kGetInCurrentLocFormList:
+	case FUNC_ID::kGetInWorldspace:
+	case FUNC_ID::kGetInZone:
+	case FUNC_ID::kGetKeywordDataForCurrentLocation:
+	case FUNC_ID::kIsInInterior:
+	case FUNC_ID::kIsInSameCurrentLocAsRef:
+	case FUNC_ID::kIsPlayerInRegion:
+	case FUNC_ID::kLocationHasKeyword:
+		return CONDITION_INPUT::Location;
+	case FUNC_ID::kGetGlobalValue:
+	case FUNC_ID::kGetQuestRunning:
+	case FUNC_ID::kGetQuestCompleted:
+	case FUNC_ID::kGetQuestVariable:
+	case FUNC_ID::kGetVMQuestVariable:
+	case FUNC_ID::kGetScriptVariable:
+	case FUNC_ID::kGetVMScriptVariable:
+	case FUNC_ID::kGetStage:
+	case FUNC_ID::kGetStageDone:
+		return CONDITION_INPUT::Global;
+	default:
+		return CONDITION_INPUT::ActorState;
+	}
+}
+
+CONDITION_INPUT ConditionParser::GetConditionInputs(const CompiledCondition* a_condition)
+{
+	REX::EnumSet<CONDITION_INPUT, std::uint8_t> inputs{ CONDITION_INPUT::None };
+
+	if (!a_condition) {
+		return inputs.get();
+	}
+
+	for (const auto& item : a_condition->GetItems()) {
+		if (const auto& function = item.data.functionData.function; function) {
+			auto funcInputs = GetFuncInputs(*function);
+			// these read the subject's cell or location, and only the player's is sampled. any other subject can move unseen
+			if (funcInputs == CONDITION_INPUT::Location && !IsSubjectIndependent(*function) && !IsPlayerSubject(item.data)) {
+				funcInputs = CONDITION_INPUT::ActorState;
+			}
+			inputs.set(funcInputs);
+		} else {
+			inputs.set(CONDITION_INPUT::Polled);
+		}
+		if (item.data.object == RE::CONDITIONITEMOBJECT::kCombatTarget) {
+			inputs.set(CONDITION_INPUT::ActorState);
+		}
+	}
+
+	return inputs.get();
+}
+
+bool ConditionParser::IsPlayerSubject(const RE::CONDITION_ITEM_DATA& a_data)
+{
+	return a_data.object == RE::CONDITIONITEMOBJECT::kRef && a_data.runOnRef.get().get() == RE::PlayerCharacter::GetSingleton();
+}
+
+bool ConditionParser::IsSubjectIndependent(FUNC_ID a_funcID)
+{
+	switch (a_funcID) {
+	case FUNC_ID::kIsRaining:
+	case FUNC_ID::kIsSnowing:
+	case FUNC_ID::kIsPleasant:
+	case FUNC_ID::kIsCloudy:
+	case FUNC_ID::kGetIsCurrentWeather:
+	case FUNC_ID::kGetCurrentWeatherPercent:
+	case FUNC_ID::kGetWindSpeed:
+	case FUNC_ID::kGetCurrentTime:
+	case FUNC_ID::kGetDayOfWeek:
+	case FUNC_ID::kGetRealHoursPassed:
+	case FUNC_ID::kIsTimePassing:
+	case FUNC_ID::kGetGlobalValue:
+	case FUNC_ID::kGetQuestRunning:
+	case FUNC_ID::kGetQuestCompleted:
+	case FUNC_ID::kGetQuestVariable:
+	case FUNC_ID::kGetVMQuestVariable:
+	case FUNC_ID::kGetStage:
+	case FUNC_ID::kGetStageDone:
+	case FUNC_ID::kMenuMode:
+	case FUNC_ID::kIsPC1stPerson:
+	case FUNC_ID::kIsPCSleeping:
+	case FUNC_ID::kIsPCAMurderer:
+	case FUNC_ID::kGetPCIsClass:
+	case FUNC_ID::kGetPCIsRace:
+	case FUNC_ID::kGetPCIsSex:
+	case FUNC_ID::kGetPCInFaction:
+	case FUNC_ID::kGetPCMiscStat:
+	case FUNC_ID::kIsPlayerInRegion:
+	case FUNC_ID::kIsXBox:
+	case FUNC_ID::kIsPS3:
+	case FUNC_ID::kIsWin32:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool ConditionParser::IsSubjectIndependent(const RE::TESCondition& a_condition)
+{
+	if (!a_condition.head) {
+		return false;
+	}
+
+	// only the function decides. an explicit subject (PlayerRef, ref editorIDs) still runs with the light's ref as the
+	// condition target, which the function is free to read
+	for (auto item = a_condition.head; item; item = item->next) {
+		const auto& function = item->data.functionData.function;
+		if (!function || !IsSubjectIndependent(*function)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+ConditionInputs ConditionInputs::Sample()
+{
+	ConditionInputs inputs;
+
+	if (const auto calendar = RE::Calendar::GetSingleton()) {
+		inputs.gameMinute = static_cast<std::uint32_t>(calendar->GetCurrentGameTime() * 24.0f * 60.0f);
+	}
+
+	if (const auto sky = RE::Sky::GetSingleton()) {
+		inputs.weather = sky->currentWeather ? sky->currentWeather->GetFormID() : 0;
+		inputs.lastWeather = sky->lastWeather ? sky->lastWeather->GetFormID() : 0;
+		inputs.weatherPct = static_cast<std::uint8_t>(std::clamp(sky->currentWeatherPct, 0.0f, 1.0f) * 20.0f);
+	}
+
+	if (const auto player = RE::PlayerCharacter::GetSingleton()) {
+		const auto cell = player->GetParentCell();
+		const auto location = player->GetCurrentLocation();
+		inputs.cell = cell ? cell->GetFormID() : 0;
+		inputs.location = location ? location->GetFormID() : 0;
+	}
+
+	return inputs;
+}
+
+CONDITION_INPUT ConditionInputs::GetChanged(const ConditionInputs& a_rhs) const
+{
+	REX::EnumSet<CONDITION_INPUT, std::uint8_t> changed{ CONDITION_INPUT::None };
+
+	if (gameMinute != a_rhs.gameMinute) {
+		changed.set(CONDITION_INPUT::GameHour);
+	}
+	if (weather != a_rhs.weather || lastWeather != a_rhs.lastWeather || weatherPct != a_rhs.weatherPct) {
+		changed.set(CONDITION_INPUT::Weather);
+	}
+	if (cell != a_rhs.cell || location != a_rhs.location) {
+		changed.set(CONDITION_INPUT::Location);
+	}
+
+	return changed.get();
+}
+
+void ConditionInputsClock::Update(std::uint64_t a_frame)
+{
+	{
+		std::shared_lock readLock(lock);
+		if (frame == a_frame) {
+			return;
+		}
+	}
+
+	std::unique_lock writeLock(lock);
+	if (frame == a_frame) {
+		return;
+	}
+	frame = a_frame;
+	inputs = ConditionInputs::Sample();
+}
+
+ConditionInputs ConditionInputsClock::Get() const
+{
+	std::shared_lock readLock(lock);
+	return inputs;
+}
+
 RE::TESForm* ConditionParser::LookupForm(const std::string& a_str)
 {
 	auto formOrEditorID = dist::get_record(a_str);
@@ -582,6 +797,29 @@ RE::TESForm* ConditionParser::LookupForm(const std::string& a_str)
 	return nullptr;
 }
 
+RE::BGSKeyword* ConditionParser::LookupKeyword(const std::string& a_editorID)
+{
+	auto& stats = LoadReport::GetSingleton()->postProcess;
+
+	// keyword editorIDs are always loaded, so index them once instead of scanning the form array per param
+	std::call_once(keywordIndexFlag, [&]() {
+		LoadReport::ScopedTimer timer(stats.keywordIndexTime);
+
+		const auto& keywordArray = RE::TESDataHandler::GetSingleton()->GetFormArray<RE::BGSKeyword>();
+		keywordIndex.reserve(keywordArray.size());
+		for (const auto& keyword : keywordArray) {
+			if (keyword && !keyword->formEditorID.empty()) {
+				keywordIndex.emplace(keyword->formEditorID.c_str(), keyword);
+			}
+		}
+	});
+
+	stats.keywordLookups++;
+
+	const auto it = keywordIndex.find(a_editorID);
+	return it != keywordIndex.end() ? it->second : nullptr;
+}
+
 bool ConditionParser::ParseVoidParam(const std::string& a_str, VOID_PARAM& a_param, PARAM_TYPE a_type)
 {
 	switch (a_type) {
@@ -730,11 +968,7 @@ bool ConditionParser::ParseVoidParam(const std::string& a_str, VOID_PARAM& a_par
 	case PARAM_TYPE::kKeyword:
 		{
 			if (dist::get_record_type(a_str) == dist::kEditorID) {
-				const auto& keywordArray = RE::TESDataHandler::GetSingleton()->GetFormArray<RE::BGSKeyword>();
-				const auto  it = std::ranges::find_if(keywordArray, [&](const auto& keyword) { return keyword->formEditorID == a_str.c_str(); });
-				if (it != keywordArray.end()) {
-					a_param.ptr = *it;
-				}
+				a_param.ptr = LookupKeyword(a_str);
 			} else {
 				a_param.ptr = LookupForm(a_str);
 			}
@@ -747,36 +981,84 @@ bool ConditionParser::ParseVoidParam(const std::string& a_str, VOID_PARAM& a_par
 	return true;
 }
 
+std::string ConditionParser::NormalizeConditions(const std::vector<std::string>& a_conditionList)
+{
+	// whitespace is insignificant to the grammar, everything else (including case) is kept
+	std::string key;
+	for (const auto& condition : a_conditionList) {
+		bool pendingSpace = false;
+		for (const auto ch : condition) {
+			if (std::isspace(static_cast<unsigned char>(ch))) {
+				pendingSpace = true;
+				continue;
+			}
+			if (pendingSpace && !key.empty() && key.back() != '\n') {
+				key += ' ';
+			}
+			pendingSpace = false;
+			key += ch;
+		}
+		key += '\n';
+	}
+	return key;
+}
+
+std::shared_ptr<CompiledCondition> ConditionParser::GetCondition(const std::vector<std::string>& a_conditionList)
+{
+	auto key = NormalizeConditions(a_conditionList);
+
+	std::scoped_lock lock(conditionCacheLock);
+
+	if (auto it = conditionCache.find(key); it != conditionCache.end()) {
+		return it->second;
+	}
+
+	std::shared_ptr<RE::TESCondition> tesCondition;
+	BuildCondition(tesCondition, a_conditionList);
+	LoadReport::GetSingleton()->postProcess.conditionsBuilt++;
+
+	// the linked list is only kept long enough to flatten it
+	std::shared_ptr<CompiledCondition> condition;
+	if (tesCondition) {
+		condition = std::make_shared<CompiledCondition>(*tesCondition, IsSubjectIndependent(*tesCondition));
+	}
+
+	return conditionCache.emplace(std::move(key), std::move(condition)).first->second;
+}
+
+std::optional<std::string> ConditionParser::ValidateCondition(const std::string& a_condition)
+{
+	if (const auto tokens = ConditionFunctions::Validate(a_condition); !tokens) {
+		return std::format("column {}: {}", tokens.error().column, tokens.error().message);
+	}
+
+	return std::nullopt;
+}
+
 void ConditionParser::BuildCondition(std::shared_ptr<RE::TESCondition>& a_condition, const std::vector<std::string>& a_conditionList)
 {
-	static srell::regex condRegex{ R"((\w+)?\s*(\w+)\s+(\w+)(?:\s+(\w+))?\s*([=!<>]+)\s*([\d.]+)\s*(AND|OR)?)" };
+	RE::TESConditionItem* tail = nullptr;
 
 	for (auto& condition : a_conditionList) {
-		srell::cmatch match;
-		if (!srell::regex_match(condition.c_str(), match, condRegex)) {
+		const auto tokens = ConditionTokens::Tokenize(condition);
+		if (!tokens) {
 			continue;
 		}
 
-		auto& subject = match[1];
-		auto& functionID = match[2];
-		auto& param1 = match[3];
-		auto& param2 = match[4];
-		auto& opCode = match[5];
-		auto& value = match[6];
-		auto& andOR = match[7];
+		const auto& [subject, functionID, param1, param2, opCode, value, isOR] = *tokens;
 
 		RE::CONDITION_ITEM_DATA condData{};
 		// subject
-		if (subject.str() == "Self") {
+		if (subject == "Self"sv) {
 			condData.object = RE::CONDITIONITEMOBJECT::kSelf;
-		} else if (subject.str() == "CombatTarget") {
+		} else if (subject == "CombatTarget"sv) {
 			condData.object = RE::CONDITIONITEMOBJECT::kCombatTarget;
-		} else {
+		} else if (!subject.empty()) {
 			RE::TESForm* refForm{};
-			if (subject.str() == "PlayerRef") {
+			if (subject == "PlayerRef"sv) {
 				refForm = RE::PlayerCharacter::GetSingleton();
 			} else {
-				refForm = LookupForm(subject.str());
+				refForm = LookupForm(std::string(subject));
 			}
 			if (auto ref = refForm ? refForm->AsReference() : nullptr) {
 				condData.runOnRef = ref->CreateRefHandle();
@@ -784,57 +1066,36 @@ void ConditionParser::BuildCondition(std::shared_ptr<RE::TESCondition>& a_condit
 			}
 		}
 		// funcID
-		if (auto it = funcIDs.find(functionID.str()); it != funcIDs.end()) {
+		if (auto it = ConditionFunctions::funcIDs.find(functionID); it != ConditionFunctions::funcIDs.end()) {
 			condData.functionData.function = static_cast<FUNC_ID>(it->second);
 		} else {
 			continue;
 		}
 		auto [param1Type, param2Type] = GetFuncType(*condData.functionData.function);
 		// param1
-		if (param1Type && param1.matched) {
+		if (param1Type && !param1.empty()) {
 			VOID_PARAM param{};
-			if (ParseVoidParam(param1.str(), param, *param1Type)) {
+			if (ParseVoidParam(std::string(param1), param, *param1Type)) {
 				condData.functionData.params[0] = std::bit_cast<void*>(param);
 			} else {
 				continue;
 			}
 		}
 		// param2
-		if (param2Type && param2.matched) {
+		if (param2Type && !param2.empty()) {
 			VOID_PARAM param{};
-			if (ParseVoidParam(param2.str(), param, *param2Type)) {
+			if (ParseVoidParam(std::string(param2), param, *param2Type)) {
 				condData.functionData.params[1] = std::bit_cast<void*>(param);
 			} else {
 				continue;
 			}
 		}
 		//opcodes
-		switch (string::const_hash(opCode.str())) {
-		case "=="_h:
-			condData.flags.opCode = OP_CODE::kEqualTo;
-			break;
-		case "!="_h:
-			condData.flags.opCode = OP_CODE::kNotEqualTo;
-			break;
-		case ">"_h:
-			condData.flags.opCode = OP_CODE::kGreaterThan;
-			break;
-		case ">="_h:
-			condData.flags.opCode = OP_CODE::kGreaterThanOrEqualTo;
-			break;
-		case "<"_h:
-			condData.flags.opCode = OP_CODE::kLessThan;
-			break;
-		case "<="_h:
-			condData.flags.opCode = OP_CODE::kLessThanOrEqualTo;
-			break;
-		default:
-			continue;
-		}
+		condData.flags.opCode = opCode;
 		// value
-		condData.comparisonValue.f = string::to_num<float>(value.str());
+		condData.comparisonValue.f = value;
 		// andOr
-		condData.flags.isOR = string::iequals(andOR.str(), "OR"sv);
+		condData.flags.isOR = isOR;
 
 		if (!a_condition) {
 			a_condition = std::make_shared<RE::TESCondition>();
@@ -844,14 +1105,18 @@ void ConditionParser::BuildCondition(std::shared_ptr<RE::TESCondition>& a_condit
 		newNode->data = condData;
 		newNode->next = nullptr;
 
-		auto* current = a_condition->head;
-		if (a_condition->head == nullptr) {
-			a_condition->head = newNode;
-		} else {
-			while (current->next != nullptr) {
-				current = current->next;
+		// keep the tail instead of walking the list for every item
+		if (!tail) {
+			tail = a_condition->head;
+			while (tail && tail->next) {
+				tail = tail->next;
 			}
-			current->next = newNode;
 		}
+		if (tail) {
+			tail->next = newNode;
+		} else {
+			a_condition->head = newNode;
+		}
+		tail = newNode;
 	}
 }
@@ -0,0 +1,114 @@
+#include "ConditionTokens.h"
+
+std::expected<ConditionTokens, ConditionTokens::Error> ConditionTokens::Tokenize(std::string_view a_condition)
+{
+	// ascii classes, same as the old regex's \s and \w. <cctype> is a call per character
+	constexpr auto is_space = [](char a_ch) { return a_ch == ' ' || (a_ch >= '\t' && a_ch <= '\r'); };
+	constexpr auto is_word = [](char a_ch) { return (a_ch >= 'a' && a_ch <= 'z') || (a_ch >= 'A' && a_ch <= 'Z') || (a_ch >= '0' && a_ch <= '9') || a_ch == '_'; };
+	constexpr auto is_op = [](char a_ch) { return a_ch == '=' || a_ch == '!' || a_ch == '<' || a_ch == '>'; };
+	constexpr auto is_value = [](char a_ch) { return (a_ch >= '0' && a_ch <= '9') || a_ch == '.'; };
+
+	std::size_t pos = 0;
+
+	const auto skip_spaces = [&]() {
+		while (pos < a_condition.size() && is_space(a_condition[pos])) {
+			++pos;
+		}
+	};
+	const auto read_while = [&](auto&& a_pred) {
+		const auto start = pos;
+		while (pos < a_condition.size() && a_pred(a_condition[pos])) {
+			++pos;
+		}
+		return a_condition.substr(start, pos - start);
+	};
+	const auto error = [&](std::string_view a_message) {
+		return std::unexpected(Error{ pos + 1, a_message });
+	};
+
+	// words up to the operator
+	std::array<std::string_view, 4> words{};
+	std::size_t                     numWords = 0;
+
+	skip_spaces();
+	while (pos < a_condition.size() && is_word(a_condition[pos])) {
+		if (numWords == words.size()) {
+			return error("too many parameters");
+		}
+		words[numWords++] = read_while(is_word);
+		skip_spaces();
+	}
+
+	// the subject is required, as it was in the regex this replaced
+	if (numWords < 3) {
+		constexpr std::array missing{ "expected subject"sv, "expected function"sv, "expected parameter"sv };
+		return error(missing[numWords]);
+	}
+
+	ConditionTokens tokens;
+	switch (numWords) {
+	case 3:
+		tokens.subject = words[0];
+		tokens.function = words[1];
+		tokens.param1 = words[2];
+		break;
+	default:
+		tokens.subject = words[0];
+		tokens.function = words[1];
+		tokens.param1 = words[2];
+		tokens.param2 = words[3];
+		break;
+	}
+
+	// operator
+	const auto opStart = pos;
+	switch (string::const_hash(read_while(is_op))) {
+	case "=="_h:
+		tokens.opCode = OP_CODE::kEqualTo;
+		break;
+	case "!="_h:
+		tokens.opCode = OP_CODE::kNotEqualTo;
+		break;
+	case ">"_h:
+		tokens.opCode = OP_CODE::kGreaterThan;
+		break;
+	case ">="_h:
+		tokens.opCode = OP_CODE::kGreaterThanOrEqualTo;
+		break;
+	case "<"_h:
+		tokens.opCode = OP_CODE::kLessThan;
+		break;
+	case "<="_h:
+		tokens.opCode = OP_CODE::kLessThanOrEqualTo;
+		break;
+	default:
+		pos = opStart;
+		return error(pos < a_condition.size() && is_op(a_condition[pos]) ? "invalid operator" : "expected operator");
+	}
+
+	// value
+	skip_spaces();
+	const auto value = read_while(is_value);
+	if (const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), tokens.value); value.empty() || ec != std::errc{} || ptr != value.data() + value.size()) {
+		pos -= value.size();
+		return error("expected value");
+	}
+
+	// AND/OR
+	skip_spaces();
+	if (pos < a_condition.size()) {
+		const auto andOR = read_while(is_word);
+		if (andOR == "OR"sv) {
+			tokens.isOR = true;
+		} else if (andOR != "AND"sv) {
+			pos -= andOR.size();
+			return error("expected AND or OR");
+		}
+		skip_spaces();
+		if (pos < a_condition.size()) {
+			return error("unexpected character");
+		}
+	}
+
+	return tokens;
+}
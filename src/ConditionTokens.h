@@ -0,0 +1,24 @@
+#pragma once
+
+using OP_CODE = RE::CONDITION_ITEM_DATA::OpCode;
+
+// Subject Function Param1 [Param2] Op Value [AND|OR], views into the source string
+struct ConditionTokens
+{
+	struct Error
+	{
+		std::size_t      column;  // 1-based
+		std::string_view message;
+	};
+
+	static std::expected<ConditionTokens, Error> Tokenize(std::string_view a_condition);
+
+	// members
+	std::string_view subject;
+	std::string_view function;
+	std::string_view param1;
+	std::string_view param2;
+	OP_CODE          opCode{ OP_CODE::kEqualTo };
+	float            value{ 0.0f };
+	bool             isOR{ false };
+};
@@ -0,0 +1,225 @@
+#include "ConfigCache.h"
+#include "Settings.h"
+
+namespace
+{
+	template <class S>
+	void PackSequence(const std::shared_ptr<S>& a_sequence, ConfigCache::SequenceData<S>& a_data)
+	{
+		if (a_sequence) {
+			a_data.coefficients = a_sequence->coefficients;
+			a_data.samples = a_sequence->samples;
+			a_data.sampleRate = a_sequence->sampleRate;
+		}
+	}
+
+	// anything that doesn't fit the decoded keys is left for PrecomputeControllers and BakeControllers to rebuild
+	template <class S>
+	void UnpackSequence(const ConfigCache::SequenceData<S>& a_data, const std::shared_ptr<S>& a_sequence)
+	{
+		if (!a_sequence || a_sequence->keys.size() < 2) {
+			return;
+		}
+		if (a_data.coefficients.size() == a_sequence->keys.size() - 1) {
+			a_sequence->coefficients = a_data.coefficients;
+		}
+		if (a_data.samples.size() >= 2 && a_data.sampleRate > 0.0f) {
+			a_sequence->samples = a_data.samples;
+			a_sequence->sampleRate = a_data.sampleRate;
+		}
+	}
+}
+
+namespace ConfigCache
+{
+	std::filesystem::path GetPath()
+	{
+		auto path = logger::log_directory();
+		if (!path) {
+			return {};
+		}
+		*path /= std::format("{}.cache", Version::PROJECT);
+		return *path;
+	}
+
+	std::optional<std::uint64_t> HashConfigFiles(const std::vector<std::filesystem::path>& a_paths, std::vector<std::string>& a_buffers)
+	{
+		std::size_t seed = 0;
+		bool        readAll = true;
+
+		boost::hash_combine(seed, VERSION);
+		boost::hash_combine(seed, Version::NAME);
+
+		a_buffers.clear();
+		a_buffers.reserve(a_paths.size());
+		for (const auto& path : a_paths) {
+			auto& buffer = a_buffers.emplace_back();
+			if (glz::file_to_buffer(buffer, path.string()) != glz::error_code::none) {
+				buffer.clear();  // left for the parser to read again and report
+				readAll = false;
+				continue;
+			}
+			boost::hash_combine(seed, path.string());
+			boost::hash_combine(seed, std::string_view(buffer));
+		}
+
+		if (!readAll) {
+			return std::nullopt;
+		}
+
+		return seed;
+	}
+
+	std::uint64_t HashLoadOrder()
+	{
+		std::size_t seed = 0;
+
+		if (const auto dataHandler = RE::TESDataHandler::GetSingleton()) {
+			for (const auto& file : dataHandler->files) {
+				if (!file || file->compileIndex == 0xFF) {
+					continue;
+				}
+				boost::hash_combine(seed, std::string_view(file->fileName));
+				boost::hash_combine(seed, file->compileIndex);
+#ifndef SKYRIMVR
+				boost::hash_combine(seed, file->smallFileCompileIndex);
+#endif
+			}
+		}
+
+		return seed;
+	}
+
+	std::uint64_t HashSettings()
+	{
+		std::size_t seed = 0;
+
+		boost::hash_combine(seed, Settings::GetSingleton()->ShouldBakeControllers());
+
+		return seed;
+	}
+
+	bool ReadHeader(Header& a_header)
+	{
+		std::ifstream file(GetPath(), std::ios::binary);
+		if (!file.read(reinterpret_cast<char*>(&a_header), sizeof(Header))) {
+			return false;
+		}
+
+		return a_header.magic == MAGIC && a_header.version == VERSION;
+	}
+
+	bool Read(Header& a_header, Tables& a_tables)
+	{
+		std::ifstream file(GetPath(), std::ios::binary | std::ios::ate);
+		if (!file) {
+			return false;
+		}
+
+		const auto size = static_cast<std::size_t>(file.tellg());
+		if (size <= sizeof(Header)) {
+			return false;
+		}
+
+		// single bulk read; BEVE decodes straight out of the buffer
+		std::string buffer(size, '\0');
+		file.seekg(0);
+		if (!file.read(buffer.data(), size)) {
+			return false;
+		}
+
+		std::memcpy(&a_header, buffer.data(), sizeof(Header));
+		if (a_header.magic != MAGIC || a_header.version != VERSION) {
+			return false;
+		}
+
+		if (auto err = glz::read_beve(a_tables, std::string_view(buffer).substr(sizeof(Header)))) {
+			logger::error("Failed to read config cache ({})", glz::format_error(err));
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Write(const Header& a_header, const Tables& a_tables)
+	{
+		const auto path = GetPath();
+		if (path.empty()) {
+			return false;
+		}
+
+		std::string buffer;
+		if (auto err = glz::write_beve(a_tables, buffer)) {
+			logger::error("Failed to write config cache ({})", glz::format_error(err));
+			return false;
+		}
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(&a_header), sizeof(Header));
+		file.write(buffer.data(), buffer.size());
+
+		return file.good();
+	}
+
+	LightEntry Pack(const Config::LightSourceData& a_light)
+	{
+		LightEntry entry{ a_light };
+
+		std::visit([&](const auto& filteredData) {
+			const auto& [filter, data] = filteredData;
+			const auto& lightData = data.data.data;
+
+			entry.whiteListForms = filter.whiteListForms;
+			entry.blackListForms = filter.blackListForms;
+			entry.lightForm = lightData.light ? lightData.light->GetFormID() : 0;
+			entry.emittanceForm = lightData.emittanceForm ? lightData.emittanceForm->GetFormID() : 0;
+
+			const auto& lightSource = data.data;
+			PackSequence(lightSource.colorController, entry.controllers.color);
+			PackSequence(lightSource.radiusController, entry.controllers.radius);
+			PackSequence(lightSource.fadeController, entry.controllers.fade);
+			PackSequence(lightSource.positionController, entry.controllers.position);
+			PackSequence(lightSource.rotationController, entry.controllers.rotation);
+		},
+			a_light);
+
+		return entry;
+	}
+
+	std::optional<Config::LightSourceData> Unpack(const LightEntry& a_entry)
+	{
+		auto light = a_entry.light;
+
+		const bool valid = std::visit([&](auto& filteredData) {
+			auto& lightSource = filteredData.get();
+
+			lightSource.data.light = RE::TESForm::LookupByID<RE::TESObjectLIGH>(a_entry.lightForm);
+			if (!lightSource.data.IsValid()) {
+				return false;
+			}
+			lightSource.data.emittanceForm = a_entry.emittanceForm != 0 ? RE::TESForm::LookupByID(a_entry.emittanceForm) : nullptr;
+			lightSource.ReadConditions();
+
+			UnpackSequence(a_entry.controllers.color, lightSource.colorController);
+			UnpackSequence(a_entry.controllers.radius, lightSource.radiusController);
+			UnpackSequence(a_entry.controllers.fade, lightSource.fadeController);
+			UnpackSequence(a_entry.controllers.position, lightSource.positionController);
+			UnpackSequence(a_entry.controllers.rotation, lightSource.rotationController);
+			lightSource.PrecomputeControllers();  // no-ops for sequences restored above
+			lightSource.ConvertRotationController();
+			lightSource.BakeControllers();
+
+			filteredData.filter.whiteListForms = a_entry.whiteListForms;
+			filteredData.filter.blackListForms = a_entry.blackListForms;
+
+			return true;
+		},
+			light);
+
+		if (!valid) {
+			return std::nullopt;
+		}
+
+		return light;
+	}
+}
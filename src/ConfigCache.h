@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ConfigData.h"
+
+// binary snapshot of post-processed configs, rebound to live forms on load
+namespace ConfigCache
+{
+	constexpr std::uint32_t MAGIC{ 'LPCC' };
+	constexpr std::uint32_t VERSION{ 9 };
+
+	struct Header
+	{
+		std::uint32_t magic{ MAGIC };
+		std::uint32_t version{ VERSION };
+		std::uint64_t configHash{ 0 };
+		std::uint64_t loadOrderHash{ 0 };
+		std::uint64_t settingsHash{ 0 };  // settings that change the cached data, only known after the ini is read
+	};
+
+	// what a keyframe sequence derives from its keys, which only the cache stores
+	template <class S>
+	struct SequenceData
+	{
+		decltype(S::coefficients) coefficients;
+		decltype(S::samples)      samples;
+		float                     sampleRate{ 0.0f };
+	};
+
+	struct ControllerData
+	{
+		SequenceData<ColorKeyframeSequence>    color;
+		SequenceData<FloatKeyframeSequence>    radius;
+		SequenceData<FloatKeyframeSequence>    fade;
+		SequenceData<PositionKeyframeSequence> position;
+		SequenceData<RotationKeyframeSequence> rotation;
+	};
+
+	// forms are stored as FormIDs, which are only valid for the load order they were resolved in
+	struct LightEntry
+	{
+		Config::LightSourceData light;
+		ControllerData          controllers;
+		FlatSet<RE::FormID>     whiteListForms;
+		FlatSet<RE::FormID>     blackListForms;
+		RE::FormID              lightForm{ 0 };
+		RE::FormID              emittanceForm{ 0 };
+	};
+
+	struct Tables
+	{
+		std::vector<LightEntry>                                         lights;
+		std::vector<std::pair<std::string, std::vector<std::uint32_t>>> models;         // model path -> light indices
+		std::vector<std::pair<RE::FormID, std::vector<std::uint32_t>>>  visualEffects;  // effect formID -> light indices
+	};
+
+	std::filesystem::path GetPath();
+
+	// hashes the contents of every file, nullopt if one can't be read. the buffers are kept by path index so a cache miss doesn't read them again
+	std::optional<std::uint64_t> HashConfigFiles(const std::vector<std::filesystem::path>& a_paths, std::vector<std::string>& a_buffers);
+	std::uint64_t HashLoadOrder();
+	std::uint64_t HashSettings();
+
+	// header is stored raw in front of the BEVE encoded tables so it can be checked without decoding them
+	bool ReadHeader(Header& a_header);
+	bool Read(Header& a_header, Tables& a_tables);
+	bool Write(const Header& a_header, const Tables& a_tables);
+
+	LightEntry                             Pack(const Config::LightSourceData& a_light);
+	std::optional<Config::LightSourceData> Unpack(const LightEntry& a_entry);
+}
+
+template <class S>
+struct glz::meta<ConfigCache::SequenceData<S>>
+{
+	using T = ConfigCache::SequenceData<S>;
+	static constexpr auto value = object(
+		"coefficients", &T::coefficients,
+		"samples", &T::samples,
+		"sampleRate", &T::sampleRate);
+};
+
+template <>
+struct glz::meta<ConfigCache::ControllerData>
+{
+	using T = ConfigCache::ControllerData;
+	static constexpr auto value = object(
+		"color", &T::color,
+		"radius", &T::radius,
+		"fade", &T::fade,
+		"position", &T::position,
+		"rotation", &T::rotation);
+};
+
+template <>
+struct glz::meta<ConfigCache::LightEntry>
+{
+	using T = ConfigCache::LightEntry;
+	static constexpr auto value = object(
+		"light", &T::light,
+		"controllers", &T::controllers,
+		"whiteListForms", &T::whiteListForms,
+		"blackListForms", &T::blackListForms,
+		"lightForm", &T::lightForm,
+		"emittanceForm", &T::emittanceForm);
+};
+
+template <>
+struct glz::meta<ConfigCache::Tables>
+{
+	using T = ConfigCache::Tables;
+	static constexpr auto value = object(
+		"lights", &T::lights,
+		"models", &T::models,
+		"visualEffects", &T::visualEffects);
+};
@@ -1,8 +1,12 @@
 #include "ConfigData.h"
+#include "ConditionParser.h"
+#include "LoadReport.h"
 #include "SourceData.h"
 
 void Config::Filter::PostProcess()
 {
+	LoadReport::ScopedTimer timer(LoadReport::GetSingleton()->postProcess.formLookupTime);
+
 	constexpr auto post_process = [](StringSet& a_stringSet, FlatSet<RE::FormID>& a_FormIDSet) {
 		for (auto& str : a_stringSet) {
 			if (auto formID = RE::GetFormID(str); formID != 0) {
@@ -51,35 +55,157 @@ bool Config::Filter::IsWhitelisted(const std::unique_ptr<SourceAttachData>& a_sr
 	return false;
 }
 
+bool Config::PostProcess(Config::LightSourceData& a_lightData)
+{
+	bool failedPostProcess = false;
+	std::visit(overload{
+				   [&](Config::FilteredPointData& pointData) {
+					   failedPostProcess = !pointData.get().PostProcess();
+					   if (!failedPostProcess) {
+						   pointData.filter.PostProcess();
+					   }
+				   },
+				   [&](Config::FilteredNodeData& nodeData) {
+					   failedPostProcess = !nodeData.get().PostProcess();
+					   if (!failedPostProcess) {
+						   nodeData.filter.PostProcess();
+					   }
+				   } },
+		a_lightData);
+	return !failedPostProcess;
+}
+
 void Config::PostProcess(Config::LightSourceVec& a_lightDataVec)
 {
 	std::erase_if(a_lightDataVec, [](auto& attachLightData) {
-		bool failedPostProcess = false;
+		return !PostProcess(attachLightData);
+	});
+}
+
+std::vector<std::string> Config::Validate(const std::vector<Config::Format>& a_configs)
+{
+	std::vector<std::string> messages;
+
+	const auto validate_light = [&](std::size_t a_entry, const LIGH::LightSourceData& a_lightSource) {
+		if (a_lightSource.lightEDID.empty()) {
+			messages.push_back(std::format("entry {} : light has no editorID", a_entry));
+		}
+		for (const auto& condition : a_lightSource.conditions) {
+			if (auto error = ConditionParser::ValidateCondition(condition)) {
+				messages.push_back(std::format("entry {} : {} : condition \"{}\" ({})", a_entry, a_lightSource.lightEDID, condition, *error));
+			}
+		}
+		for (const auto& window : a_lightSource.data.schedule.windows) {
+			if (auto error = window.Validate()) {
+				messages.push_back(std::format("entry {} : {} : schedule {}-{} ({})", a_entry, a_lightSource.lightEDID, window.on, window.off, *error));
+			}
+		}
+	};
+
+	for (const auto [entry, multiData] : std::views::enumerate(a_configs)) {
 		std::visit(overload{
-					   [&](Config::FilteredPointData& pointData) {
-						   failedPostProcess = !pointData.get().PostProcess();
-						   if (!failedPostProcess) {
-							   pointData.filter.PostProcess();
-						   }
+					   [&](const Config::MultiAddonSet&) {
+						   messages.push_back(std::format("entry {} : deprecated addonNodes entry skipped", entry));
 					   },
-					   [&](Config::FilteredNodeData& nodeData) {
-						   failedPostProcess = !nodeData.get().PostProcess();
-						   if (!failedPostProcess) {
-							   nodeData.filter.PostProcess();
+					   [&](const auto& set) {
+						   for (const auto& light : set.lights) {
+							   std::visit([&](const auto& filteredData) { validate_light(entry, filteredData.data.data); }, light);
 						   }
 					   } },
-			attachLightData);
-		return failedPostProcess;
-	});
+			multiData);
+	}
+
+	return messages;
 }
 
-void Config::PostProcess(Config::AddonLightSourceVec& a_lightDataVec)
+namespace
 {
-	std::erase_if(a_lightDataVec, [](auto& filterData) {
-		bool failedPostProcess = !filterData.data.PostProcess();
-		if (!failedPostProcess) {
-			filterData.filter.PostProcess();
+	std::size_t string_size(const std::string& a_str)
+	{
+		return a_str.capacity() > std::string().capacity() ? a_str.capacity() + 1 : 0;
+	}
+
+	std::size_t string_set_size(const StringSet& a_set)
+	{
+		std::size_t size = a_set.bucket_count() * sizeof(std::string);
+		for (const auto& str : a_set) {
+			size += string_size(str);
 		}
-		return failedPostProcess;
-	});
+		return size;
+	}
+}
+
+std::size_t Config::GetControllerMemoryUsage(const LIGH::LightSourceData& a_lightSource)
+{
+	constexpr auto sequence_size = [](const auto& a_sequence) -> std::size_t {
+		if (!a_sequence) {
+			return 0;
+		}
+		using sequence_t = std::remove_cvref_t<decltype(*a_sequence)>;
+		return sizeof(sequence_t) +
+		       a_sequence->keys.capacity() * sizeof(typename decltype(sequence_t::keys)::value_type) +
+		       a_sequence->coefficients.capacity() * sizeof(typename decltype(sequence_t::coefficients)::value_type) +
+		       a_sequence->samples.capacity() * sizeof(typename decltype(sequence_t::samples)::value_type);
+	};
+
+	return sequence_size(a_lightSource.colorController) + sequence_size(a_lightSource.radiusController) + sequence_size(a_lightSource.fadeController) +
+	       sequence_size(a_lightSource.positionController) + sequence_size(a_lightSource.rotationController) + sequence_size(a_lightSource.rotationQuaternions);
+}
+
+std::size_t Config::GetMemoryUsage(const Config::LightSourceData& a_lightData)
+{
+	std::size_t size = sizeof(Config::LightSourceData);
+
+	std::visit([&](const auto& filteredData) {
+		const auto& [filter, data] = filteredData;
+
+		size += string_set_size(filter.whiteList) + string_set_size(filter.blackList);
+		size += (filter.whiteListForms.bucket_count() + filter.blackListForms.bucket_count()) * sizeof(RE::FormID);
+
+		if constexpr (std::is_same_v<std::remove_cvref_t<decltype(data)>, Config::PointData>) {
+			size += data.points.capacity() * sizeof(RE::NiPoint3);
+		} else {
+			size += string_set_size(data.nodes);
+		}
+
+		const auto& lightSource = data.data;
+		size += string_size(lightSource.lightEDID) + string_size(lightSource.emittanceFormEDID);
+		size += string_set_size(lightSource.data.conditionalNodes);
+		size += lightSource.data.schedule.windows.capacity() * sizeof(LightSchedule::Window);
+		size += lightSource.conditions.capacity() * sizeof(std::string);
+		for (const auto& condition : lightSource.conditions) {
+			size += string_size(condition);
+		}
+		size += GetControllerMemoryUsage(lightSource);
+		size += lightSource.aioController.keys.capacity() * sizeof(Keyframe<LightAnimData>);
+	},
+		a_lightData);
+
+	return size;
+}
+
+std::size_t Config::GetMemoryUsage(const std::vector<Config::Format>& a_configs)
+{
+	std::size_t size = a_configs.capacity() * sizeof(Config::Format);
+
+	const auto lights_size = [](const Config::LightSourceVec& a_lights) {
+		return std::ranges::fold_left(a_lights, (a_lights.capacity() - a_lights.size()) * sizeof(Config::LightSourceData), [](std::size_t a_sum, const auto& a_light) {
+			return a_sum + GetMemoryUsage(a_light);
+		});
+	};
+
+	for (const auto& multiData : a_configs) {
+		std::visit(overload{
+					   [&](const Config::MultiModelSet& models) {
+						   size += string_set_size(models.models) + lights_size(models.lights);
+					   },
+					   [&](const Config::MultiVisualEffectSet& visualEffects) {
+						   size += string_set_size(visualEffects.visualEffects) + lights_size(visualEffects.lights);
+					   },
+					   [&](const Config::MultiAddonSet&) {
+					   } },
+			multiData);
+	}
+
+	return size;
 }
@@ -46,13 +46,11 @@ namespace Config
 		T      data;
 	};
 
-	using FilteredRawData = FilteredData<LIGH::LightSourceData>;
-	using AddonLightSourceVec = std::vector<FilteredRawData>;
-
 	using FilteredPointData = FilteredData<PointData>;
 	using FilteredNodeData = FilteredData<NodeData>;
 	using LightSourceData = std::variant<FilteredPointData, FilteredNodeData>;
 	using LightSourceVec = std::vector<LightSourceData>;
+	using LightSourceIndices = std::vector<std::uint32_t>;  // into the shared light definitions
 
 	struct MultiModelSet
 	{
@@ -66,28 +64,24 @@ namespace Config
 		LightSourceVec lights;
 	};
 
-	// deprecated
+	// deprecated, still recognised so old configs load but its contents are skipped unread
 	struct MultiAddonSet
-	{
-		FlatSet<std::uint32_t>       addonNodes;
-		std::vector<FilteredRawData> lights;
-	};
+	{};
 
 	using Format = std::variant<MultiModelSet, MultiVisualEffectSet, MultiAddonSet>;
 
+	bool PostProcess(LightSourceData& a_lightData);
 	void PostProcess(LightSourceVec& a_lightDataVec);
-	void PostProcess(AddonLightSourceVec& a_lightDataVec);
-}
 
-template <>
-struct glz::meta<Config::FilteredRawData>
-{
-	using T = Config::FilteredRawData;
-	static constexpr auto value = object(
-		"whiteList", [](auto&& self) -> auto& { return self.filter.whiteList; },
-		"blackList", [](auto&& self) -> auto& { return self.filter.blackList; },
-		"data", &T::data);
-};
+	// game independent checks on freshly parsed configs, returns one message per problem
+	// the condition checks are ConditionFunctions::Validate, which the offline validator in tools/ runs as well
+	std::vector<std::string> Validate(const std::vector<Format>& a_configs);
+
+	// approximate, including heap allocations
+	std::size_t GetMemoryUsage(const LightSourceData& a_lightData);
+	std::size_t GetControllerMemoryUsage(const LIGH::LightSourceData& a_lightSource);  // keyframe sequences, shared by every instance
+	std::size_t GetMemoryUsage(const std::vector<Format>& a_configs);
+}
 
 template <>
 struct glz::meta<Config::FilteredPointData>
@@ -132,8 +126,7 @@ struct glz::meta<Config::MultiVisualEffectSet>
 template <>
 struct glz::meta<Config::MultiAddonSet>
 {
-	using T = Config::MultiAddonSet;
 	static constexpr auto value = object(
-		"addonNodes", &T::addonNodes,
-		"lights", &T::lights);
+		"addonNodes", glz::skip{},
+		"lights", glz::skip{});
 };
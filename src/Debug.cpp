@@ -163,18 +163,15 @@ namespace Debug
 
 		static bool Execute(const RE::SCRIPT_PARAMETER*, RE::SCRIPT_FUNCTION::ScriptData*, RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*, double&, std::uint32_t&)
 		{
-			const auto refs = LightManager::GetSingleton()->GetLightAttachedRefs();
-
-			LightManager::GetSingleton()->ReloadConfigs();
+			const auto refs = LightManager::GetSingleton()->ReloadConfigs();
 
+			// only refs using rebuilt models are relit, in place
 			SKSE::GetTaskInterface()->AddTask([refs]() {
 				for (auto& ref : refs) {
 					if (ref) {
-						ref->Disable();
-						ref->Enable(false);
+						LightManager::GetSingleton()->RelightReference(ref.get());
 					}
 				}
-				RE::TES::GetSingleton()->PurgeBufferedCells();
 			});
 
 			RE::ConsoleLog::GetSingleton()->Print("%u refs reloaded", refs.size());
@@ -1,7 +1,5 @@
 #include "LightControllers.h"
 
-#include "LightData.h"
-
 bool LightAnimData::GetValidColor() const { return IsValid(color); }
 
 bool LightAnimData::GetValidFade() const { return IsValid(fade); }
@@ -12,47 +10,94 @@ bool LightAnimData::GetValidTranslation() const { return IsValid(translation); }
 
 bool LightAnimData::GetValidRotation() const { return IsValid(rotation); }
 
-LightControllers::LightControllers(const LIGH::LightSourceData& a_src)
+std::shared_ptr<QuaternionKeyframeSequence> ConvertRotationSequence(const RotationKeyframeSequence& a_sequence)
 {
-	const bool randomAnimStart = a_src.data.flags.any(LIGHT_FLAGS::RandomAnimStart);
+	auto result = std::make_shared<QuaternionKeyframeSequence>();
+	result->interpolation = a_sequence.interpolation;
+
+	const auto& keys = a_sequence.keys;
+	if (keys.empty()) {
+		return result;
+	}
+
+	result->keys.emplace_back(keys.front().time, RE::EulerToQuaternion(keys.front().value));
+
+	for (std::size_t i = 0; i + 1 < keys.size(); ++i) {
+		const auto& start = keys[i];
+		const auto& end = keys[i + 1];
+		const auto  delta = end.value - start.value;
+
+		// a quaternion pair can't describe half a turn or more, so large swings (e.g. 0 to 360) are split. pieces of at most
+		// 30 degrees per axis keep combined rotations well under that and close to the path the Euler lerp took
+		std::uint32_t pieces = 1;
+		if (a_sequence.interpolation == INTERPOLATION::kLinear) {
+			pieces = std::max(1u, static_cast<std::uint32_t>(std::ceil(std::max({ std::abs(delta.x), std::abs(delta.y), std::abs(delta.z) }) / 30.0f)));
+		}
+
+		for (std::uint32_t j = 1; j <= pieces; ++j) {
+			const float u = static_cast<float>(j) / pieces;
+
+			// neighbouring quaternions are kept in the same hemisphere so slerp takes the short arc
+			const auto& previous = result->keys.back().value;
+			auto        q = RE::EulerToQuaternion(start.value + delta * u);
+			if (q.w * previous.w + q.x * previous.x + q.y * previous.y + q.z * previous.z < 0.0f) {
+				q = { -q.w, -q.x, -q.y, -q.z };
+			}
+			result->keys.emplace_back(start.time + (end.time - start.time) * u, q);
+		}
+	}
 
-#define INIT_CONTROLLER(controller)                                        \
-	if (!a_src.controller.empty()) {                                       \
-		(controller) = LightController(a_src.controller, randomAnimStart); \
+	return result;
+}
+
+void AnimationClock::Update(std::uint64_t a_frame, float a_delta)
+{
+	{
+		std::shared_lock readLock(lock);
+		if (frame == a_frame) {
+			return;
+		}
 	}
 
-	INIT_CONTROLLER(colorController)
-	INIT_CONTROLLER(radiusController)
-	INIT_CONTROLLER(fadeController)
-	INIT_CONTROLLER(positionController)
-	INIT_CONTROLLER(rotationController)
+	std::unique_lock writeLock(lock);
+	if (frame == a_frame) {
+		return;
+	}
+	frame = a_frame;
+	time += a_delta;
+}
 
-#undef INIT_CONTROLLER
+double AnimationClock::Get() const
+{
+	std::shared_lock readLock(lock);
+	return time;
 }
 
-void LightControllers::UpdateAnimation(const RE::NiPointer<RE::NiPointLight>& a_light, float a_delta, float a_scalingFactor)
+void LightControllers::UpdateAnimation(const RE::NiPointer<RE::NiPointLight>& a_light, double a_clock, float a_scalingFactor)
 {
 	if (colorController) {
-		a_light->diffuse = colorController->GetValue(a_delta);
+		a_light->diffuse = colorController->GetValue(a_clock);
 	}
 	if (radiusController) {
-		const auto newRadius = radiusController->GetValue(a_delta) * a_scalingFactor;
+		const auto newRadius = radiusController->GetValue(a_clock) * a_scalingFactor;
 		a_light->radius = { newRadius, newRadius, newRadius };
 		a_light->SetLightAttenuation(newRadius);
 	}
 	if (fadeController) {
-		a_light->fade = fadeController->GetValue(a_delta);
+		a_light->fade = fadeController->GetValue(a_clock);
 	}
 	if (const auto parentNode = a_light->parent) {
 		if (positionController) {
-			parentNode->local.translate = positionController->GetValue(a_delta);
+			parentNode->local.translate = positionController->GetValue(a_clock);
 		}
-		if (rotationController) {
-			auto rotation = rotationController->GetValue(a_delta);
+		if (quaternionController) {
+			RE::SetRotation(parentNode->local.rotate, quaternionController->GetValue(a_clock));
+		} else if (rotationController) {
+			auto rotation = rotationController->GetValue(a_clock);
 			RE::WrapRotation(rotation);
 			parentNode->local.rotate.SetEulerAnglesXYZ(rotation.x, rotation.y, rotation.z);
 		}
-		if (positionController || rotationController) {
+		if (positionController || rotationController || quaternionController) {
 			UpdateNode(parentNode);
 		}
 	}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Rotation.h"
+
 enum class INTERPOLATION : std::uint8_t
 {
 	kStep,
@@ -62,55 +64,221 @@ public:
 	bool empty() const { return keys.empty(); }
 
 	float GetDuration() const { return keys.back().time - keys.front().time; }
-	T     GetValue(const float a_time)
+
+	// one segment of the curve in power form, value = ((a * t + b) * t + c) * t + d
+	struct Segment
+	{
+		T     a{};
+		T     b{};
+		T     c{};
+		T     d{};
+		float t{ 0.0f };
+	};
+
+	// a keyframe pair expanded at load, so evaluating it is a single Horner step
+	struct Coefficients
 	{
-		for (std::size_t i = lastIndex; i < keys.size() - 1; ++i) {
-			const auto& currKeyframe = keys[i];
-			const auto& nextKeyframe = keys[i + 1];
+		T     a{};
+		T     b{};
+		T     c{};
+		T     d{};
+		float invLength{ 0.0f };  // 1 / segment duration
+	};
+
+	static T Evaluate(const Segment& a_segment)
+	{
+		return ((a_segment.a * a_segment.t + a_segment.b) * a_segment.t + a_segment.c) * a_segment.t + a_segment.d;
+	}
+
+	// sequences are shared between every light using them, so the segment cursor is owned by the caller
+	T GetValue(const float a_time, std::uint32_t& a_cursor) const
+	{
+		if (keys.size() < 2) {
+			return keys.front().value;
+		}
+
+		if constexpr (std::is_same_v<T, RE::NiQuaternion>) {
+			return GetRotation(a_time, a_cursor);
+		} else {
+			if (!samples.empty()) {
+				return GetSampledValue(a_time);
+			}
 
-			if (a_time >= currKeyframe.time && a_time <= nextKeyframe.time) {
-				lastIndex = i;
-				return Interpolate(a_time, currKeyframe, nextKeyframe);
+			if (!Seek(a_time, a_cursor)) {
+				return keys.front().value;
 			}
+
+			return Evaluate(GetKeyframeSegment(a_time, a_cursor));
+		}
+	}
+
+	// converts every keyframe pair into polynomial coefficients, skipped if they were loaded from the cache
+	void Precompute()
+	{
+		if (keys.size() < 2 || coefficients.size() == keys.size() - 1) {
+			return;
+		}
+
+		coefficients.clear();
+		coefficients.reserve(keys.size() - 1);
+		for (std::size_t i = 0; i + 1 < keys.size(); ++i) {
+			coefficients.push_back(GetCoefficients(keys[i], keys[i + 1]));
+		}
+	}
+
+	// samples one cycle into a lookup table, returns the largest deviation from the keyframed curve (checked between samples)
+	float Bake(std::size_t a_sampleCount)
+	{
+		// step curves are already a single lookup and would be smoothed by the table
+		if (keys.size() < 2 || interpolation == INTERPOLATION::kStep || GetDuration() <= 0.0f || a_sampleCount < 2) {
+			return 0.0f;
+		}
+
+		const float startTime = keys.front().time;
+		const float rate = static_cast<float>(a_sampleCount - 1) / GetDuration();
+
+		std::uint32_t cursor = 0;
+
+		std::vector<T> baked;
+		baked.reserve(a_sampleCount);
+		for (std::size_t i = 0; i < a_sampleCount; ++i) {
+			baked.push_back(GetValue(std::min(startTime + static_cast<float>(i) / rate, keys.back().time), cursor));
 		}
 
-		lastIndex = 0;
-		return keys.front().value;
+		float error = 0.0f;
+		for (std::size_t i = 0; i + 1 < a_sampleCount; ++i) {
+			const auto exact = GetValue(startTime + (static_cast<float>(i) + 0.5f) / rate, cursor);
+			const auto sampled = 0.5f * baked[i] + 0.5f * baked[i + 1];
+			error = std::max(error, GetError(exact, sampled));
+		}
+
+		samples = std::move(baked);
+		sampleRate = rate;
+
+		return error;
 	}
 
 	// members
 	INTERPOLATION                   interpolation{ INTERPOLATION::kLinear };
 	std::vector<Keyframe<T, index>> keys{};
-	std::size_t                     lastIndex{ 0 };
+	std::vector<Coefficients>       coefficients{};      // one per segment
+	std::vector<T>                  samples{};           // baked curve, evenly spaced over one cycle
+	float                           sampleRate{ 0.0f };  // samples per second
 
 private:
-	T Interpolate(float a_time, const Keyframe<T, index>& a_start, const Keyframe<T, index>& a_end)
+	std::pair<std::size_t, float> GetSamplePosition(float a_time) const
 	{
-		float t = (a_time - a_start.time) / (a_end.time - a_start.time);
+		const float maxPos = static_cast<float>(samples.size() - 1);
+		const float pos = std::clamp((a_time - keys.front().time) * sampleRate, 0.0f, maxPos);
+		const auto  i = std::min(static_cast<std::size_t>(pos), samples.size() - 2);
+
+		return { i, pos - static_cast<float>(i) };
+	}
+
+	T GetSampledValue(float a_time) const
+	{
+		const auto [i, t] = GetSamplePosition(a_time);
+		return (1 - t) * samples[i] + t * samples[i + 1];
+	}
+
+	static float GetError(const T& a_lhs, const T& a_rhs)
+	{
+		if constexpr (std::is_same_v<float, T>) {
+			return std::abs(a_lhs - a_rhs);
+		} else if constexpr (std::is_same_v<RE::NiColor, T>) {
+			return std::max({ std::abs(a_lhs.red - a_rhs.red), std::abs(a_lhs.green - a_rhs.green), std::abs(a_lhs.blue - a_rhs.blue) });
+		} else if constexpr (std::is_same_v<RE::NiPoint3, T>) {
+			return std::max({ std::abs(a_lhs.x - a_rhs.x), std::abs(a_lhs.y - a_rhs.y), std::abs(a_lhs.z - a_rhs.z) });
+		} else {
+			return 0.0f;
+		}
+	}
+
+	bool InSegment(std::uint32_t a_index, float a_time) const
+	{
+		return a_time >= keys[a_index].time && a_time <= keys[a_index + 1].time;
+	}
+
+	// moves the cursor to the segment containing a_time, false if a_time lies outside the curve
+	bool Seek(float a_time, std::uint32_t& a_cursor) const
+	{
+		// time only moves forward within a cycle, so the answer is almost always the cached segment or the one after it (wrapping to the first)
+		const auto lastSegment = static_cast<std::uint32_t>(keys.size() - 2);
+		if (a_cursor <= lastSegment) {
+			if (InSegment(a_cursor, a_time)) {
+				return true;
+			}
+			if (const auto nextIndex = a_cursor == lastSegment ? 0 : a_cursor + 1; InSegment(nextIndex, a_time)) {
+				a_cursor = nextIndex;
+				return true;
+			}
+		}
+
+		// random start or a large delta
+		const auto it = std::ranges::upper_bound(keys, a_time, {}, &Keyframe<T, index>::time);
+		if (it == keys.begin() || a_time > keys.back().time) {
+			a_cursor = 0;
+			return false;
+		}
+
+		a_cursor = std::min(static_cast<std::uint32_t>(std::distance(keys.begin(), it)) - 1, lastSegment);
+		return true;
+	}
+
+	// quaternion keys are only built for step and linear curves, cubic rotation stays on the Euler keys
+	T GetRotation(float a_time, std::uint32_t& a_cursor) const
+	{
+		if (!Seek(a_time, a_cursor)) {
+			return keys.front().value;
+		}
+
+		const auto& start = keys[a_cursor];
+		if (interpolation == INTERPOLATION::kStep) {
+			return start.value;
+		}
+
+		const auto& end = keys[a_cursor + 1];
+
+		const float length = end.time - start.time;
+		return RE::Slerp(start.value, end.value, length > 0.0f ? (a_time - start.time) / length : 0.0f);
+	}
+
+	Segment GetKeyframeSegment(float a_time, std::uint32_t a_segment) const
+	{
+		const auto& start = keys[a_segment];
+		const auto  coeffs = a_segment < coefficients.size() ? coefficients[a_segment] : GetCoefficients(start, keys[a_segment + 1]);
+
+		return { coeffs.a, coeffs.b, coeffs.c, coeffs.d, (a_time - start.time) * coeffs.invLength };
+	}
+
+	Coefficients GetCoefficients(const Keyframe<T, index>& a_start, const Keyframe<T, index>& a_end) const
+	{
+		const float length = a_end.time - a_start.time;
+		const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
 
 		switch (interpolation) {
 		case INTERPOLATION::kStep:
-			return a_start.value;
+			return { .d = a_start.value };
 		case INTERPOLATION::kLinear:
-			return (1 - t) * a_start.value + t * a_end.value;
+			return { .c = a_end.value - a_start.value, .d = a_start.value, .invLength = invLength };
 		case INTERPOLATION::kCubic:
 			{
-				// Hermite interpolation formula
-				float t2 = t * t;
-				float t3 = t2 * t;
-
-				float h1 = (2 * t3) - (3 * t2) + 1;
-				float h2 = 1 - h1;
-				float h3 = t3 - (2 * t2) + t;
-				float h4 = t3 - t2;
-
-				return h1 * a_start.value +
-				       h2 * a_end.value +
-				       h3 * a_start.forward +
-				       h4 * a_end.backward;
+				// Hermite basis functions regrouped by power of t
+				const auto& p0 = a_start.value;
+				const auto& p1 = a_end.value;
+				const auto& m0 = a_start.forward;
+				const auto& m1 = a_end.backward;
+
+				return {
+					.a = 2.0f * p0 - 2.0f * p1 + m0 + m1,
+					.b = 3.0f * p1 - 3.0f * p0 - 2.0f * m0 - m1,
+					.c = m0,
+					.d = p0,
+					.invLength = invLength
+				};
 			}
 		default:
-			return T();
+			return {};
 		}
 	}
 };
@@ -120,29 +288,49 @@ class LightController
 {
 public:
 	LightController() = default;
-	explicit LightController(const KeyframeSequence<T, index>& a_sequence, bool a_randomAnimStart) :
-		sequence(a_sequence),
-		cycleDuration(a_sequence.GetDuration())
+	explicit LightController(const std::shared_ptr<const KeyframeSequence<T, index>>& a_sequence, bool a_randomAnimStart) :
+		sequence(a_sequence)
 	{
 		if (a_randomAnimStart) {
-			currentTime = clib_util::RNG().generate(0.0f, cycleDuration);
+			startTime = clib_util::RNG().generate(0.0f, sequence->GetDuration());
 		}
 	}
 
-	T GetValue(const float a_time)
+	T GetValue(const double a_clock)
 	{
-		currentTime = std::fmod(currentTime + a_time, cycleDuration);
-		return sequence.GetValue(currentTime);
+		return sequence->GetValue(GetTime(a_clock), cursor);
 	}
 
 	bool GetValidFade() const { return false; }
 	bool GetValidTranslation() const { return false; }
 
 private:
+	// the cycle position is derived from the shared clock rather than accumulated, so a light that skipped updates resumes in phase
+	float GetTime(const double a_clock)
+	{
+		if (!phase) {
+			phase = startTime - a_clock;  // the first update starts the cycle at startTime
+		}
+		return static_cast<float>(std::fmod(a_clock + *phase, static_cast<double>(sequence->GetDuration())));
+	}
+
 	// members
-	KeyframeSequence<T, index> sequence;
-	float                      cycleDuration{ -1.0f };
-	float                      currentTime{ 0.0f };
+	std::shared_ptr<const KeyframeSequence<T, index>> sequence;  // owned by the light definition
+	std::optional<double>                             phase{};   // offset from the animation clock
+	float                                             startTime{ 0.0f };
+	std::uint32_t                                     cursor{ 0 };
+};
+
+// animated game time, advanced once per frame and shared by every controller
+struct AnimationClock
+{
+	void   Update(std::uint64_t a_frame, float a_delta);
+	double Get() const;
+
+	// members
+	mutable std::shared_mutex lock;
+	std::uint64_t             frame{ 0 };
+	double                    time{ 0.0 };  // seconds, kept in double so long sessions don't lose precision
 };
 
 template <>
@@ -152,6 +340,16 @@ struct glz::meta<INTERPOLATION>
 	static constexpr auto value = enumerate("Step", kStep, "Linear", kLinear, "Cubic", kCubic);
 };
 
+// only the keys are part of the config grammar, coefficients and samples are derived at load or restored from the config cache
+template <class T, std::uint32_t index>
+struct glz::meta<KeyframeSequence<T, index>>
+{
+	using S = KeyframeSequence<T, index>;
+	static constexpr auto value = object(
+		"interpolation", &S::interpolation,
+		"keys", &S::keys);
+};
+
 template <>
 struct glz::meta<Keyframe<LightAnimData>>
 {
@@ -215,31 +413,39 @@ struct glz::meta<Keyframe<float>>
 
 using PositionKeyframe = Keyframe<RE::NiPoint3, 0>;
 using RotationKeyframe = Keyframe<RE::NiPoint3, 1>;
+using QuaternionKeyframe = Keyframe<RE::NiQuaternion>;
 using ColorKeyframe = Keyframe<RE::NiColor>;
 using FloatKeyframe = Keyframe<float>;
 
 using AIOKeyframeSequence = KeyframeSequence<LightAnimData>;
 using PositionKeyframeSequence = KeyframeSequence<RE::NiPoint3, 0>;
 using RotationKeyframeSequence = KeyframeSequence<RE::NiPoint3, 1>;
+using QuaternionKeyframeSequence = KeyframeSequence<RE::NiQuaternion>;
 using ColorKeyframeSequence = KeyframeSequence<RE::NiColor>;
 using FloatKeyframeSequence = KeyframeSequence<float>;
 
 using PositionController = LightController<RE::NiPoint3, 0>;
 using RotationController = LightController<RE::NiPoint3, 1>;
+using QuaternionController = LightController<RE::NiQuaternion>;
 using ColorController = LightController<RE::NiColor>;
 using FloatController = LightController<float>;
 
+// step and linear rotation keys are converted to quaternions, so the node matrix can be written without trig
+// cubic curves are left to the Euler path, where precomputed or baked keys are cheaper than squad
+std::shared_ptr<QuaternionKeyframeSequence> ConvertRotationSequence(const RotationKeyframeSequence& a_sequence);
+
 struct LightControllers
 {
 	LightControllers() = default;
 	LightControllers(const LIGH::LightSourceData& a_src);
 
-	void UpdateAnimation(const RE::NiPointer<RE::NiPointLight>& a_light, float a_delta, float a_scalingFactor);
+	void UpdateAnimation(const RE::NiPointer<RE::NiPointLight>& a_light, double a_clock, float a_scalingFactor);
 
 	// members
-	std::optional<ColorController>    colorController{};
-	std::optional<FloatController>    radiusController{};
-	std::optional<FloatController>    fadeController{};
-	std::optional<PositionController> positionController{};
-	std::optional<RotationController> rotationController{};
+	std::optional<ColorController>      colorController{};
+	std::optional<FloatController>      radiusController{};
+	std::optional<FloatController>      fadeController{};
+	std::optional<PositionController>   positionController{};
+	std::optional<RotationController>   rotationController{};
+	std::optional<QuaternionController> quaternionController{};  // replaces rotationController for step and linear keys
 };
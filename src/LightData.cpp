@@ -1,5 +1,6 @@
 #include "LightData.h"
 #include "ConditionParser.h"
+#include "LoadReport.h"
 #include "Settings.h"
 #include "SourceData.h"
 
@@ -419,41 +420,129 @@ LightData::MARKER_CREATE_PARAMS LightData::GetDebugMarkerParams() const
 	return { "marker_light.nif", "marker_light:0", 0.25f, RE::NiPoint3() };
 }
 
+// lives with the light definition so LightControllers.cpp doesn't depend on it, the benchmarks build that file on its own
+LightControllers::LightControllers(const LIGH::LightSourceData& a_src)
+{
+	const bool randomAnimStart = a_src.data.flags.any(LIGHT_FLAGS::RandomAnimStart);
+
+#define INIT_CONTROLLER(controller, sequence)                   \
+	if (a_src.sequence && !a_src.sequence->empty()) {           \
+		(controller).emplace(a_src.sequence, randomAnimStart); \
+	}
+
+	INIT_CONTROLLER(colorController, colorController)
+	INIT_CONTROLLER(radiusController, radiusController)
+	INIT_CONTROLLER(fadeController, fadeController)
+	INIT_CONTROLLER(positionController, positionController)
+	INIT_CONTROLLER(quaternionController, rotationQuaternions)
+	if (!quaternionController) {
+		INIT_CONTROLLER(rotationController, rotationController)
+	}
+
+#undef INIT_CONTROLLER
+}
+
 void LIGH::LightSourceData::ReadConditions()
 {
 	if (!conditions.empty()) {
-		ConditionParser::BuildCondition(data.conditions, conditions);
+		auto& stats = LoadReport::GetSingleton()->postProcess;
+
+		LoadReport::ScopedTimer timer(stats.conditionTime);
+		data.conditions = ConditionParser::GetCondition(conditions);
+		data.conditionInputs = ConditionParser::GetConditionInputs(data.conditions.get());
+		stats.conditionLists++;
 	}
 }
 
-bool LIGH::LightSourceData::PostProcess()
+void LIGH::LightSourceData::PrecomputeControllers()
 {
-	if (!lightEDID.contains("|")) {
-		data.light = RE::TESForm::LookupByEditorID<RE::TESObjectLIGH>(lightEDID);
+	const auto precompute = [](auto& a_controller) {
+		if (a_controller) {
+			a_controller->Precompute();
+		}
+	};
+
+	// covers sequences split out of lightController as well
+	precompute(colorController);
+	precompute(radiusController);
+	precompute(fadeController);
+	precompute(positionController);
+	precompute(rotationController);
+}
+
+void LIGH::LightSourceData::ConvertRotationController()
+{
+	// cubic curves stay on the Euler keys
+	if (rotationController && !rotationController->empty() && rotationController->interpolation != INTERPOLATION::kCubic) {
+		rotationQuaternions = ConvertRotationSequence(*rotationController);
 	} else {
-		auto edids = string::split(lightEDID, "|");
-		for (const auto& edid : edids) {
-			if (auto form = RE::TESForm::LookupByEditorID<RE::TESObjectLIGH>(edid)) {
-				data.light = form;
-				break;
+		rotationQuaternions.reset();
+	}
+}
+
+void LIGH::LightSourceData::BakeControllers()
+{
+	if (!bake && !Settings::GetSingleton()->ShouldBakeControllers()) {
+		return;
+	}
+
+	auto& stats = LoadReport::GetSingleton()->postProcess;
+
+	LoadReport::ScopedTimer timer(stats.bakeTime);
+
+	const auto bake_controller = [&](auto& a_controller, float& a_maxError) {
+		if (a_controller && !a_controller->empty() && a_controller->samples.empty()) {
+			a_maxError = std::max(a_maxError, a_controller->Bake(BAKE_SAMPLES));
+			if (!a_controller->samples.empty()) {
+				stats.bakedControllers++;
 			}
 		}
+	};
+
+	bake_controller(colorController, stats.bakeColorError);
+	bake_controller(radiusController, stats.bakeRadiusError);
+	bake_controller(fadeController, stats.bakeFadeError);
+	bake_controller(positionController, stats.bakePositionError);
+	if (!rotationQuaternions) {
+		bake_controller(rotationController, stats.bakeRotationError);
 	}
+}
 
-	if (!data.IsValid()) {
-		return false;
-	}
+bool LIGH::LightSourceData::PostProcess()
+{
+	{
+		LoadReport::ScopedTimer timer(LoadReport::GetSingleton()->postProcess.formLookupTime);
+
+		if (!lightEDID.contains("|")) {
+			data.light = RE::TESForm::LookupByEditorID<RE::TESObjectLIGH>(lightEDID);
+		} else {
+			auto edids = string::split(lightEDID, "|");
+			for (const auto& edid : edids) {
+				if (auto form = RE::TESForm::LookupByEditorID<RE::TESObjectLIGH>(edid)) {
+					data.light = form;
+					break;
+				}
+			}
+		}
 
-	data.emittanceForm = RE::TESForm::LookupByEditorID(emittanceFormEDID);
+		if (!data.IsValid()) {
+			return false;
+		}
+
+		data.emittanceForm = RE::TESForm::LookupByEditorID(emittanceFormEDID);
+	}
 
 	ReadConditions();
+	PrecomputeControllers();
+	ConvertRotationController();
+	BakeControllers();
 
 	return true;
 }
 
 bool LIGH::LightSourceData::IsStaticLight() const
 {
-	return data.offset == RE::NiPoint3::Zero() && data.rotation == RE::MATRIX_ZERO && positionController.empty() && rotationController.empty();
+	return data.offset == RE::NiPoint3::Zero() && data.rotation == RE::MATRIX_ZERO && (!positionController || positionController->empty()) && (!rotationController || rotationController->empty());
 }
 
 RE::NiNode* LIGH::LightSourceData::GetOrCreateNode(RE::NiNode* a_root, const RE::NiPoint3& a_point, std::uint32_t a_index) const
@@ -600,7 +689,7 @@ void REFR_LIGH::ReattachLight(RE::TESObjectREFR* a_ref)
 
 bool REFR_LIGH::ShouldUpdateConditions(const ConditionUpdateFlags a_flags) const
 {
-	if (!data.conditions || a_flags == ConditionUpdateFlags::Skip) {
+	if ((!data.conditions && data.schedule.empty()) || a_flags == ConditionUpdateFlags::Skip) {
 		return false;
 	}
 
@@ -612,7 +701,8 @@ bool REFR_LIGH::ShouldUpdateConditions(const ConditionUpdateFlags a_flags) const
 		return false;
 	}
 
-	if (a_flags == ConditionUpdateFlags::Forced) {
+	// schedules flip on their own hours, whatever the condition update flags ask for
+	if (a_flags == ConditionUpdateFlags::Forced || a_flags == ConditionUpdateFlags::Schedule) {
 		return true;
 	}
 
@@ -636,23 +726,284 @@ bool REFR_LIGH::ShouldUpdateConditions(const ConditionUpdateFlags a_flags) const
 	return true;
 }
 
-void REFR_LIGH::UpdateAnimation(float a_delta, float a_scalingFactor)
+namespace
+{
+	float wrap_hour(float a_hour)
+	{
+		const float hour = std::fmod(a_hour, 24.0f);
+		return hour < 0.0f ? hour + 24.0f : hour;
+	}
+
+	// [a_start, a_end), wrapping past midnight when a_end < a_start
+	bool in_hour_range(float a_hour, float a_start, float a_end)
+	{
+		return a_start <= a_end ? a_hour >= a_start && a_hour < a_end : a_hour >= a_start || a_hour < a_end;
+	}
+}
+
+float LightSchedule::Window::GetFactor(float a_hour) const
+{
+	const float length = wrap_hour(off - on);
+	const float elapsed = wrap_hour(a_hour - on);
+
+	if (elapsed >= length) {
+		return 0.0f;
+	}
+
+	float factor = 1.0f;
+	if (fadeIn > 0.0f && elapsed < fadeIn) {
+		factor = elapsed / fadeIn;
+	}
+	if (const float remaining = length - elapsed; fadeOut > 0.0f && remaining < fadeOut) {
+		factor = std::min(factor, remaining / fadeOut);
+	}
+
+	return factor;
+}
+
+std::optional<std::string> LightSchedule::Window::Validate() const
+{
+	if (on < 0.0f || on > 24.0f || off < 0.0f || off > 24.0f) {
+		return "hours must be between 0 and 24";
+	}
+	if (wrap_hour(on) == wrap_hour(off)) {
+		return "on and off hours are the same";
+	}
+	if (fadeIn < 0.0f || fadeOut < 0.0f) {
+		return "fade windows can't be negative";
+	}
+	if (fadeIn + fadeOut > wrap_hour(off - on)) {
+		return "fade windows are longer than the schedule";
+	}
+	return std::nullopt;
+}
+
+float LightSchedule::GetFactor(float a_hour) const
+{
+	float factor = 0.0f;
+	for (const auto& window : windows) {
+		factor = std::max(factor, window.GetFactor(a_hour));
+		if (factor >= 1.0f) {
+			break;
+		}
+	}
+	return factor;
+}
+
+bool LightSchedule::HasFades() const
+{
+	return std::ranges::any_of(windows, [](const auto& a_window) {
+		return a_window.fadeIn > 0.0f || a_window.fadeOut > 0.0f;
+	});
+}
+
+void LightSchedule::Clock::Update(std::uint64_t a_frame, bool a_force)
+{
+	if (!a_force) {
+		std::shared_lock readLock(lock);
+		if (frame == a_frame) {
+			return;
+		}
+	}
+
+	std::unique_lock writeLock(lock);
+	if (!a_force && frame == a_frame) {
+		return;
+	}
+	frame = a_frame;
+
+	const auto calendar = RE::Calendar::GetSingleton();
+	if (!calendar) {
+		return;
+	}
+
+	const float gameTime = calendar->GetCurrentGameTime();
+	const float lastHour = time.hour;
+
+	time.hour = wrap_hour(gameTime * 24.0f);
+
+	// a backwards or day long jump (loading, waiting, sleeping) can skip any number of edges
+	const float elapsed = lastGameTime ? gameTime - *lastGameTime : -1.0f;
+	lastGameTime = gameTime;
+
+	if (elapsed < 0.0f || elapsed >= 1.0f) {
+		time.changed = true;
+		return;
+	}
+
+	bool crossed = false;
+	if (!transitions.empty()) {
+		const auto next = std::ranges::upper_bound(transitions, lastHour);
+		if (time.hour >= lastHour) {
+			crossed = next != transitions.end() && *next <= time.hour;
+		} else {
+			crossed = next != transitions.end() || transitions.front() <= time.hour;
+		}
+	}
+
+	time.changed = crossed || std::ranges::any_of(fadeRanges, [&](const auto& a_range) {
+		return in_hour_range(time.hour, a_range.first, a_range.second);
+	});
+}
+
+LightSchedule::Time LightSchedule::Clock::Get() const
+{
+	std::shared_lock readLock(lock);
+	return time;
+}
+
+void LightSchedule::Clock::SetTransitions(const std::vector<const LightSchedule*>& a_schedules)
+{
+	std::unique_lock writeLock(lock);
+
+	transitions.clear();
+	fadeRanges.clear();
+
+	for (const auto& schedule : a_schedules) {
+		for (const auto& window : schedule->windows) {
+			const float on = wrap_hour(window.on);
+			const float off = wrap_hour(window.off);
+
+			transitions.push_back(on);
+			transitions.push_back(off);
+
+			if (window.fadeIn > 0.0f) {
+				fadeRanges.emplace_back(on, wrap_hour(on + window.fadeIn));
+			}
+			if (window.fadeOut > 0.0f) {
+				fadeRanges.emplace_back(wrap_hour(off - window.fadeOut), off);
+			}
+		}
+	}
+
+	std::ranges::sort(transitions);
+	transitions.erase(std::ranges::unique(transitions).begin(), transitions.end());
+
+	std::ranges::sort(fadeRanges);
+	fadeRanges.erase(std::ranges::unique(fadeRanges).begin(), fadeRanges.end());
+
+	// force the next update to re-evaluate every scheduled light
+	lastGameTime.reset();
+	frame = 0;
+}
+
+void GlobalConditions::Update(std::uint64_t a_frame)
+{
+	{
+		std::shared_lock readLock(lock);
+		if (frame == a_frame) {
+			return;
+		}
+	}
+
+	// results from older frames are left in place and refreshed on their next lookup
+	std::unique_lock writeLock(lock);
+	frame = a_frame;
+}
+
+std::optional<bool> GlobalConditions::IsTrue(const CompiledCondition* a_condition)
+{
+	if (!a_condition->IsSubjectIndependent()) {
+		return std::nullopt;
+	}
+
+	{
+		std::shared_lock readLock(lock);
+		if (const auto it = results.find(a_condition); it != results.end() && it->second.frame == frame) {
+			hits.fetch_add(1, std::memory_order_relaxed);
+			return it->second.value;
+		}
+	}
+
+	std::unique_lock writeLock(lock);
+
+	auto& result = results[a_condition];
+	if (result.frame != frame) {
+		// any ref works as the subject, these conditions never read it
+		const auto player = RE::PlayerCharacter::GetSingleton();
+		result.value = a_condition->IsTrue(player, player);
+		result.frame = frame;
+		evaluations.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		hits.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return result.value;
+}
+
+std::pair<std::uint64_t, std::uint64_t> GlobalConditions::GetStats() const
+{
+	return { hits.load(std::memory_order_relaxed), evaluations.load(std::memory_order_relaxed) };
+}
+
+bool REFR_LIGH::ConditionMemo::IsTrue(const std::shared_ptr<CompiledCondition>& a_condition, RE::TESObjectREFR* a_ref)
+{
+	const auto it = std::ranges::find_if(results, [&](const auto& a_result) {
+		return std::get<0>(a_result) == a_condition.get() && std::get<1>(a_result) == a_ref;
+	});
+	if (it != results.end()) {
+		hits.fetch_add(1, std::memory_order_relaxed);
+		return std::get<2>(*it);
+	}
+
+	if (globalConditions) {
+		if (const auto result = globalConditions->IsTrue(a_condition.get())) {
+			return *result;
+		}
+	}
+
+	evaluations.fetch_add(1, std::memory_order_relaxed);
+
+	const bool result = a_condition->IsTrue(a_ref, a_ref);
+	results.emplace_back(a_condition.get(), a_ref, result);
+
+	return result;
+}
+
+void REFR_LIGH::ConditionMemo::Reset(GlobalConditions* a_globalConditions)
+{
+	results.clear();
+	globalConditions = a_globalConditions;
+}
+
+std::pair<std::uint64_t, std::uint64_t> REFR_LIGH::ConditionMemo::GetStats()
+{
+	return { hits.load(std::memory_order_relaxed), evaluations.load(std::memory_order_relaxed) };
+}
+
+bool REFR_LIGH::ShouldPollConditions(CONDITION_INPUT a_changedInputs, bool a_timerElapsed) const
+{
+	const auto inputs = std::to_underlying(data.conditionInputs);
+
+	if (a_timerElapsed && (inputs & std::to_underlying(CONDITION_INPUT::Polled)) != 0) {
+		return true;
+	}
+
+	return (inputs & std::to_underlying(a_changedInputs)) != 0;
+}
+
+void REFR_LIGH::UpdateAnimation(double a_clock, float a_scalingFactor)
 {
 	scale = data.flags.any(LIGHT_FLAGS::IgnoreScale) ? 1.0f : a_scalingFactor;
-	lightControllers.UpdateAnimation(output.GetLight(), a_delta, scale);
+	lightControllers.UpdateAnimation(output.GetLight(), a_clock, scale);
 }
 
-void REFR_LIGH::UpdateConditions(RE::TESObjectREFR* a_ref, NodeVisHelper& a_nodeVisHelper, ConditionUpdateFlags a_flags)
+void REFR_LIGH::UpdateConditions(RE::TESObjectREFR* a_ref, NodeVisHelper& a_nodeVisHelper, ConditionMemo& a_conditionMemo, ConditionUpdateFlags a_flags, const LightSchedule::Time& a_scheduleTime)
 {
 	if (!ShouldUpdateConditions(a_flags)) {
 		return;
 	}
 
-	if (a_flags != ConditionUpdateFlags::Normal) {
+	if (a_flags != ConditionUpdateFlags::Normal && a_flags != ConditionUpdateFlags::Schedule) {
 		lastVisibleState = std::nullopt;
 	}
 
-	const bool isVisible = data.conditions->IsTrue(a_ref, a_ref);
+	if (!data.schedule.empty()) {
+		scheduleFade = data.schedule.GetFactor(a_scheduleTime.hour);
+	}
+
+	// conditions are only run while the schedule has the light on
+	const bool isVisible = scheduleFade > 0.0f && (!data.conditions || a_conditionMemo.IsTrue(data.conditions, a_ref));
 	if (lastVisibleState != isVisible) {
 		lastVisibleState = isVisible;
 
@@ -686,6 +1037,21 @@ void REFR_LIGH::UpdateEmittance() const
 	}
 }
 
+void REFR_LIGH::UpdateScheduleFade(bool a_animated) const
+{
+	if (!data.schedule.HasFades()) {
+		return;
+	}
+
+	auto& niLight = output.GetLight();
+
+	// animated fade is rewritten every frame, static fade has to be rebuilt from the base value
+	const bool fadeAnimated = a_animated && (lightControllers.fadeController || data.light->data.flags.any(RE::TES_LIGHT_FLAGS::kFlicker, RE::TES_LIGHT_FLAGS::kFlickerSlow, RE::TES_LIGHT_FLAGS::kPulse, RE::TES_LIGHT_FLAGS::kPulseSlow));
+	const float baseFade = fadeAnimated ? niLight->fade : data.GetScaledFade(scale);
+
+	niLight->fade = baseFade * scheduleFade;
+}
+
 void REFR_LIGH::UpdateVanillaFlickering() const
 {
 	auto& niLight = output.GetLight();
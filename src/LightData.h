@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ConditionParser.h"
 #include "LightControllers.h"
 
 struct SourceAttachData;
@@ -78,6 +79,53 @@ struct LightOutput
 	RE::NiPointer<RE::NiAVObject>   debugMarker{};
 };
 
+// on/off game hours for a light, driven by one per-frame hour read instead of GetCurrentTime conditions
+struct LightSchedule
+{
+	struct Window
+	{
+		float                      GetFactor(float a_hour) const;  // 0 = off, 1 = on, in between while fading
+		std::optional<std::string> Validate() const;
+
+		// members
+		float on{ 0.0f };  // hours, windows with off < on wrap past midnight
+		float off{ 0.0f };
+		float fadeIn{ 0.0f };   // hours after on
+		float fadeOut{ 0.0f };  // hours before off
+	};
+
+	// game hour shared by every scheduled light in a frame
+	struct Time
+	{
+		float hour{ 0.0f };
+		bool  changed{ true };  // a window edge was crossed or a fade is running, so scheduled lights need updating
+	};
+
+	// samples the game hour once per frame and flags the frames where any schedule can change
+	struct Clock
+	{
+		void Update(std::uint64_t a_frame, bool a_force = false);  // forced after waiting, when this frame may already be sampled
+		Time Get() const;
+
+		void SetTransitions(const std::vector<const LightSchedule*>& a_schedules);
+
+		// members
+		mutable std::shared_mutex            lock;
+		std::uint64_t                        frame{ 0 };
+		std::optional<float>                 lastGameTime{};  // days
+		Time                                 time{};
+		std::vector<float>                   transitions;  // sorted window edges across all schedules
+		std::vector<std::pair<float, float>> fadeRanges;
+	};
+
+	bool  empty() const { return windows.empty(); }
+	float GetFactor(float a_hour) const;  // highest factor across windows
+	bool  HasFades() const;
+
+	// members
+	std::vector<Window> windows;
+};
+
 struct LightData
 {
 	bool                                     GetCastsShadows() const;
@@ -122,8 +170,10 @@ struct LightData
 	RE::NiMatrix3                            rotation;
 	REX::EnumSet<LIGHT_FLAGS, std::uint32_t> flags{ LIGHT_FLAGS::None };
 	RE::TESForm*                             emittanceForm{ nullptr };
-	std::shared_ptr<RE::TESCondition>        conditions;
+	std::shared_ptr<CompiledCondition>       conditions;
+	CONDITION_INPUT                          conditionInputs{ CONDITION_INPUT::None };
 	StringSet                                conditionalNodes;
+	LightSchedule                            schedule;
 
 	constexpr static auto LP_LIGHT = "LP_Light"sv;
 	constexpr static auto LP_NODE = "LP_Node"sv;
@@ -151,6 +201,9 @@ namespace LIGH
 		LightSourceData() = default;
 
 		void ReadConditions();
+		void PrecomputeControllers();
+		void ConvertRotationController();
+		void BakeControllers();
 		bool PostProcess();
 
 		bool IsStaticLight() const;
@@ -160,16 +213,20 @@ namespace LIGH
 		RE::NiNode* GetOrCreateNode(RE::NiNode* a_root, RE::NiAVObject* a_obj, std::uint32_t a_index) const;
 
 		// members
-		LightData                data;
-		std::string              lightEDID;
-		std::string              emittanceFormEDID;
-		std::vector<std::string> conditions;
-		ColorKeyframeSequence    colorController;
-		FloatKeyframeSequence    radiusController;
-		FloatKeyframeSequence    fadeController;
-		PositionKeyframeSequence positionController;
-		RotationKeyframeSequence rotationController;
-		AIOKeyframeSequence      aioController;
+		LightData                                   data;
+		std::string                                 lightEDID;
+		std::string                                 emittanceFormEDID;
+		std::vector<std::string>                    conditions;
+		std::shared_ptr<ColorKeyframeSequence>      colorController;  // sequences are shared by every light built from this definition
+		std::shared_ptr<FloatKeyframeSequence>      radiusController;
+		std::shared_ptr<FloatKeyframeSequence>      fadeController;
+		std::shared_ptr<PositionKeyframeSequence>   positionController;
+		std::shared_ptr<RotationKeyframeSequence>   rotationController;
+		std::shared_ptr<QuaternionKeyframeSequence> rotationQuaternions;  // step and linear rotationController converted at load, not serialized
+		AIOKeyframeSequence                         aioController;
+		bool                                        bake{ false };  // sample controllers into lookup tables at load
+
+		static constexpr std::size_t BAKE_SAMPLES{ 256 };  // per cycle
 	};
 }
 
@@ -220,39 +277,78 @@ struct glz::meta<LIGH::LightSourceData>
 			}
 		}
 	};
-	static constexpr auto write_flags = [](auto&) -> auto& { return ""; };
+	static constexpr auto write_flags = [](const T& s) -> std::string {
+		constexpr std::array flagNames{
+			std::pair{ LIGHT_FLAGS::PortalStrict, "PortalStrict"sv },
+			std::pair{ LIGHT_FLAGS::Shadow, "Shadow"sv },
+			std::pair{ LIGHT_FLAGS::Simple, "Simple"sv },
+			std::pair{ LIGHT_FLAGS::InverseSquare, "InverseSquare"sv },
+			std::pair{ LIGHT_FLAGS::UpdateOnWaiting, "UpdateOnWaiting"sv },
+			std::pair{ LIGHT_FLAGS::UpdateOnCellTransition, "UpdateOnCellTransition"sv },
+			std::pair{ LIGHT_FLAGS::SyncAddonNodes, "SyncAddonNodes"sv },
+			std::pair{ LIGHT_FLAGS::IgnoreScale, "IgnoreScale"sv },
+			std::pair{ LIGHT_FLAGS::RandomAnimStart, "RandomAnimStart"sv },
+			std::pair{ LIGHT_FLAGS::NoExternalEmittance, "NoExternalEmittance"sv }
+		};
+
+		std::string output;
+		for (const auto& [flag, name] : flagNames) {
+			if (s.data.flags.any(flag)) {
+				if (!output.empty()) {
+					output += '|';
+				}
+				output += name;
+			}
+		}
+		return output;
+	};
 
 	static constexpr auto read_aioController = [](auto& s) -> bool {
 		if (!s.aioController.empty()) {
-			s.colorController.clear();
-			s.radiusController.clear();
-			s.fadeController.clear();
-			s.positionController.clear();
-			s.rotationController.clear();
-
-			s.colorController.interpolation = s.aioController.interpolation;
-			s.radiusController.interpolation = s.aioController.interpolation;
-			s.fadeController.interpolation = s.aioController.interpolation;
-			s.positionController.interpolation = s.aioController.interpolation;
-			s.rotationController.interpolation = s.aioController.interpolation;
+			const auto make_sequence = [&](auto& a_sequence) {
+				a_sequence = std::make_shared<typename std::remove_cvref_t<decltype(a_sequence)>::element_type>();
+				a_sequence->interpolation = s.aioController.interpolation;
+			};
+
+			make_sequence(s.colorController);
+			make_sequence(s.radiusController);
+			make_sequence(s.fadeController);
+			make_sequence(s.positionController);
+			make_sequence(s.rotationController);
 
 			for (auto& key : s.aioController.keys) {
 				if (key.value.GetValidColor()) {
-					s.colorController.keys.push_back(ColorKeyframe(key.time, key.value.color, key.forward.color, key.backward.color));
+					s.colorController->keys.push_back(ColorKeyframe(key.time, key.value.color, key.forward.color, key.backward.color));
 				}
 				if (key.value.GetValidRadius()) {
-					s.radiusController.keys.push_back(FloatKeyframe(key.time, key.value.radius, key.forward.radius, key.backward.radius));
+					s.radiusController->keys.push_back(FloatKeyframe(key.time, key.value.radius, key.forward.radius, key.backward.radius));
 				}
 				if (key.value.GetValidFade()) {
-					s.fadeController.keys.push_back(FloatKeyframe(key.time, key.value.fade, key.forward.fade, key.backward.fade));
+					s.fadeController->keys.push_back(FloatKeyframe(key.time, key.value.fade, key.forward.fade, key.backward.fade));
 				}
 				if (key.value.GetValidTranslation()) {
-					s.positionController.keys.push_back(PositionKeyframe(key.time, key.value.translation, key.forward.translation, key.backward.translation));
+					s.positionController->keys.push_back(PositionKeyframe(key.time, key.value.translation, key.forward.translation, key.backward.translation));
 				}
 				if (key.value.GetValidRotation()) {
-					s.rotationController.keys.push_back(RotationKeyframe(key.time, key.value.rotation, key.forward.rotation, key.backward.rotation));
+					s.rotationController->keys.push_back(RotationKeyframe(key.time, key.value.rotation, key.forward.rotation, key.backward.rotation));
 				}
 			}
+
+			const auto release_empty = [](auto& a_sequence) {
+				if (a_sequence->empty()) {
+					a_sequence.reset();
+				}
+			};
+
+			release_empty(s.colorController);
+			release_empty(s.radiusController);
+			release_empty(s.fadeController);
+			release_empty(s.positionController);
+			release_empty(s.rotationController);
+
+			// the split sequences carry everything from here on. keeping the keys would split them again when a
+			// written cache is read back, replacing sequences that already hold coefficients and baked samples
+			s.aioController.clear();
 		}
 		return true;
 	};
@@ -273,12 +369,53 @@ struct glz::meta<LIGH::LightSourceData>
 		"flags", glz::custom<read_flags, write_flags>,
 		"conditions", &T::conditions,
 		"conditionalNodes", [](auto&& self) -> auto& { return self.data.conditionalNodes; },
+		"schedule", [](auto&& self) -> auto& { return self.data.schedule; },
 		"colorController", &T::colorController,
 		"radiusController", &T::radiusController,
 		"fadeController", &T::fadeController,
 		"positionController", &T::positionController,
 		"rotationController", &T::rotationController,
-		"lightController", glz::manage<&T::aioController, read_aioController, write_aioController>);
+		"lightController", glz::manage<&T::aioController, read_aioController, write_aioController>,
+		"bake", &T::bake);
+};
+
+template <>
+struct glz::meta<LightSchedule::Window>
+{
+	using T = LightSchedule::Window;
+	static constexpr auto value = object(
+		"on", &T::on,
+		"off", &T::off,
+		"fadeIn", &T::fadeIn,
+		"fadeOut", &T::fadeOut);
+};
+
+template <>
+struct glz::meta<LightSchedule>
+{
+	static constexpr auto value = &LightSchedule::windows;
+};
+
+// results of subject independent conditions, shared by every light using them
+// a condition is evaluated on its first lookup in a frame, so lists nobody asks for cost nothing
+struct GlobalConditions
+{
+	struct Result
+	{
+		std::uint64_t frame{ 0 };  // frame the value was evaluated in
+		bool          value{ false };
+	};
+
+	void                                    Update(std::uint64_t a_frame);
+	std::optional<bool>                     IsTrue(const CompiledCondition* a_condition);  // nullopt if the condition depends on the ref
+	std::pair<std::uint64_t, std::uint64_t> GetStats() const;                              // [hits, evaluations]
+
+	// members
+	mutable std::shared_mutex                 lock;
+	std::uint64_t                             frame{ 0 };
+	FlatMap<const CompiledCondition*, Result> results;
+	std::atomic_uint64_t                      hits{ 0 };  // reused by another ref in the same frame
+	std::atomic_uint64_t                      evaluations{ 0 };
 };
 
 struct REFR_LIGH
@@ -292,6 +429,7 @@ struct REFR_LIGH
 			Forced = (1 << 1),
 			CellTransition = (1 << 2),
 			Waiting = (1 << 3),
+			Schedule = (1 << 4),
 
 			UpdateRequired = CellTransition | Waiting
 		};
@@ -312,6 +450,22 @@ struct REFR_LIGH
 		StringMap<bool> conditionalNodes{};
 	};
 
+	// lights on the same ref often share a condition list, so each one is only evaluated once per update pass
+	struct ConditionMemo
+	{
+		bool IsTrue(const std::shared_ptr<CompiledCondition>& a_condition, RE::TESObjectREFR* a_ref);
+		void Reset(GlobalConditions* a_globalConditions = nullptr);
+
+		static std::pair<std::uint64_t, std::uint64_t> GetStats();  // [hits, evaluations], excluding lists answered by GlobalConditions
+
+		// members
+		std::vector<std::tuple<const CompiledCondition*, const RE::TESObjectREFR*, bool>> results{};
+		GlobalConditions*                                                                 globalConditions{ nullptr };
+
+		static inline std::atomic_uint64_t hits{ 0 };
+		static inline std::atomic_uint64_t evaluations{ 0 };
+	};
+
 	REFR_LIGH() = default;
 	REFR_LIGH(const LIGH::LightSourceData& a_lightSource, const LightOutput& a_lightOutput, const RE::TESObjectREFRPtr& a_ref, float a_scale);
 
@@ -329,15 +483,18 @@ struct REFR_LIGH
 
 	void ReattachLight(RE::TESObjectREFR* a_ref);
 	bool ShouldUpdateConditions(ConditionUpdateFlags a_flags) const;
-	void UpdateAnimation(float a_delta, float a_scalingFactor);
-	void UpdateConditions(RE::TESObjectREFR* a_ref, NodeVisHelper& a_nodeVisHelper, ConditionUpdateFlags a_flags);
+	bool ShouldPollConditions(CONDITION_INPUT a_changedInputs, bool a_timerElapsed) const;
+	void UpdateAnimation(double a_clock, float a_scalingFactor);
+	void UpdateConditions(RE::TESObjectREFR* a_ref, NodeVisHelper& a_nodeVisHelper, ConditionMemo& a_conditionMemo, ConditionUpdateFlags a_flags, const LightSchedule::Time& a_scheduleTime);
 	void UpdateEmittance() const;
+	void UpdateScheduleFade(bool a_animated) const;
 	void UpdateVanillaFlickering() const;
 
 	LightData           data{};
 	LightOutput         output{};
 	LightControllers    lightControllers{};
 	float               scale{ 1.0f };
+	float               scheduleFade{ 1.0f };
 	std::optional<bool> lastVisibleState{};
 };
 
@@ -0,0 +1,70 @@
+#include "LoadReport.h"
+
+void LoadReport::AddFile(const std::filesystem::path& a_path, std::size_t a_bytes, std::size_t a_entries, double a_parseTime, const std::optional<std::string>& a_error)
+{
+	files.emplace_back(a_path.string(), a_bytes, a_entries, a_parseTime, a_error);
+}
+
+void LoadReport::Log() const
+{
+	logger::info("{:*^50}", "LOAD REPORT");
+
+	const auto totalBytes = std::ranges::fold_left(files, std::size_t{ 0 }, [](std::size_t a_sum, const auto& a_file) { return a_sum + a_file.bytes; });
+	const auto totalParseTime = std::ranges::fold_left(files, 0.0, [](double a_sum, const auto& a_file) { return a_sum + a_file.parseTime; });
+
+	logger::info("Settings : {:.2f} ms", settingsTime);
+	logger::info("Config files : {} files, {} bytes ({:.2f} ms parsing)", files.size(), totalBytes, totalParseTime);
+	logger::info("Read configs : {:.2f} ms", readConfigsTime);
+	if (usedConfigCache) {
+		logger::info("Load config cache : {:.2f} ms", cacheLoadTime);
+	} else {
+		logger::info("Process configs : {:.2f} ms", processConfigsTime);
+	}
+	logger::info("\tform lookups : {:.2f} ms", postProcess.formLookupTime);
+	logger::info("\tconditions : {} unique of {} total ({:.2f} ms)", postProcess.conditionsBuilt, postProcess.conditionLists, postProcess.conditionTime);
+	if (postProcess.keywordLookups > 0) {
+		logger::info("\tkeyword params : {} lookups (index built in {:.2f} ms)", postProcess.keywordLookups, postProcess.keywordIndexTime);
+	}
+	if (postProcess.bakedControllers > 0) {
+		logger::info("\tbaked controllers : {} ({:.2f} ms)", postProcess.bakedControllers, postProcess.bakeTime);
+		logger::info("\t\tmax error : color {:.4f}, radius {:.4f}, fade {:.4f}, position {:.4f}, rotation {:.4f}", postProcess.bakeColorError, postProcess.bakeRadiusError, postProcess.bakeFadeError, postProcess.bakePositionError, postProcess.bakeRotationError);
+	}
+	logger::info("Memory : models {} bytes, visual effects {} bytes, light definitions {} bytes", memory.models, memory.visualEffects, memory.lightDefinitions);
+
+	// summed from container sizes, not measured. the game loads its own data at the same time, so process memory can't isolate ours
+	// parsed lights are moved, not copied, into the definitions, so the peak is the parsed configs plus the lookup tables
+	const auto estimatedSteady = memory.models + memory.visualEffects + memory.lightDefinitions;
+	const auto estimatedPeak = memory.configs + memory.models + memory.visualEffects;
+	logger::info("\testimated peak : {} bytes, estimated steady state : {} bytes", std::max(estimatedPeak, estimatedSteady), estimatedSteady);
+
+	LogConditions();
+}
+
+void LoadReport::LogConditions() const
+{
+	const auto ratio = [](std::uint64_t a_hits, std::uint64_t a_evaluations) {
+		const auto total = a_hits + a_evaluations;
+		return total > 0 ? 100.0 * static_cast<double>(a_hits) / static_cast<double>(total) : 0.0;
+	};
+
+	if (conditions.lightEvaluations + conditions.lightHits > 0) {
+		logger::info("Light conditions : {} evaluated, {} reused ({:.1f}%)", conditions.lightEvaluations, conditions.lightHits, ratio(conditions.lightHits, conditions.lightEvaluations));
+	}
+	if (conditions.globalEvaluations + conditions.globalHits > 0) {
+		logger::info("Global conditions : {} evaluated, {} reused ({:.1f}%)", conditions.globalEvaluations, conditions.globalHits, ratio(conditions.globalHits, conditions.globalEvaluations));
+	}
+}
+
+void LoadReport::Write() const
+{
+	auto path = logger::log_directory();
+	if (!path) {
+		return;
+	}
+	*path /= std::format("{}_stats.json", Version::PROJECT);
+
+	std::string buffer;
+	if (auto err = glz::write_file_json<glz::opts{ .prettify = true }>(*this, path->string(), buffer)) {
+		logger::warn("Failed to write load report ({})", glz::format_error(err, buffer));
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+// startup profile, written to the log and to a json file next to it
+class LoadReport : public REX::Singleton<LoadReport>
+{
+public:
+	struct FileStats
+	{
+		std::string                path;
+		std::size_t                bytes{ 0 };
+		std::size_t                entries{ 0 };
+		double                     parseTime{ 0.0 };  // ms
+		std::optional<std::string> error;
+	};
+
+	struct PostProcessStats
+	{
+		double      formLookupTime{ 0.0 };    // ms
+		double      conditionTime{ 0.0 };     // ms
+		double      keywordIndexTime{ 0.0 };  // ms
+		std::size_t conditionsBuilt{ 0 };  // unique lists
+		std::size_t conditionLists{ 0 };
+		std::size_t keywordLookups{ 0 };
+		double      bakeTime{ 0.0 };  // ms
+		std::size_t bakedControllers{ 0 };
+		float       bakeColorError{ 0.0f };  // largest deviation from the keyframed curve, per channel
+		float       bakeRadiusError{ 0.0f };
+		float       bakeFadeError{ 0.0f };
+		float       bakePositionError{ 0.0f };
+		float       bakeRotationError{ 0.0f };
+	};
+
+	struct MemoryStats
+	{
+		std::size_t models{ 0 };
+		std::size_t visualEffects{ 0 };
+		std::size_t lightDefinitions{ 0 };
+		std::size_t configs{ 0 };                    // parsed configs, released after processing
+		std::size_t controllerSequences{ 0 };        // shared keyframe data
+		std::size_t controllersPerLightBefore{ 0 };  // average, when every instance copied its keyframes
+		std::size_t controllersPerLightAfter{ 0 };
+	};
+
+	// runtime counters, refreshed on every save
+	struct ConditionStats
+	{
+		std::uint64_t lightEvaluations{ 0 };
+		std::uint64_t lightHits{ 0 };  // list already evaluated for another light on the same ref
+		std::uint64_t globalEvaluations{ 0 };
+		std::uint64_t globalHits{ 0 };  // subject-independent list already evaluated this frame
+	};
+
+	// adds the elapsed time to a_total when it goes out of scope
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(double& a_total) :
+			total(a_total),
+			start(std::chrono::steady_clock::now())
+		{}
+		~ScopedTimer()
+		{
+			total += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		double&                               total;
+		std::chrono::steady_clock::time_point start;
+	};
+
+	void AddFile(const std::filesystem::path& a_path, std::size_t a_bytes, std::size_t a_entries, double a_parseTime, const std::optional<std::string>& a_error);
+
+	void Log() const;
+	void LogConditions() const;
+	void Write() const;
+
+	// members
+	double                 settingsTime{ 0.0 };        // ms
+	double                 readConfigsTime{ 0.0 };     // ms
+	double                 processConfigsTime{ 0.0 };  // ms
+	double                 cacheLoadTime{ 0.0 };       // ms
+	bool                   usedConfigCache{ false };
+	std::vector<FileStats> files;
+	PostProcessStats       postProcess;
+	MemoryStats            memory;
+	ConditionStats         conditions;
+};
+
+template <>
+struct glz::meta<LoadReport>
+{
+	using T = LoadReport;
+	static constexpr auto value = object(
+		"settingsTime", &T::settingsTime,
+		"readConfigsTime", &T::readConfigsTime,
+		"processConfigsTime", &T::processConfigsTime,
+		"cacheLoadTime", &T::cacheLoadTime,
+		"usedConfigCache", &T::usedConfigCache,
+		"files", &T::files,
+		"postProcess", &T::postProcess,
+		"memory", &T::memory,
+		"conditions", &T::conditions);
+};
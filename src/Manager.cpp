@@ -1,86 +1,551 @@
 #include "Manager.h"
+#include "ConfigCache.h"
+#include "LoadReport.h"
+#include "Settings.h"
 #include "SourceData.h"
 
-bool LightManager::ReadConfigs(bool a_reload)
+std::vector<std::filesystem::path> LightManager::GetConfigPaths()
 {
-	logger::info("{:*^50}", a_reload ? "RELOAD" : "CONFIG FILES");
+	std::vector<std::filesystem::path> paths;
 
 	std::filesystem::path dir{ R"(Data\LightPlacer)" };
-
 	if (std::error_code ec; !std::filesystem::exists(dir, ec)) {
 		logger::info("Data\\LightPlacer folder not found ({})", ec.message());
-		return false;
-	}
-
-	if (a_reload) {
-		configs.clear();
+		return paths;
 	}
 
 	for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(dir)) {
 		if (dirEntry.is_directory() || dirEntry.path().extension() != ".json"sv) {
 			continue;
 		}
-		logger::info("{} {}...", a_reload ? "Reloading" : "Reading", dirEntry.path().string());
-		std::string                 buffer;
-		std::vector<Config::Format> tmpConfig;
-		auto                        err = glz::read_file_json(tmpConfig, dirEntry.path().string(), buffer);
-		if (err) {
-			logger::error("\terror:{}", glz::format_error(err, buffer));
+		paths.push_back(dirEntry.path());
+	}
+
+	// merge order must not depend on directory enumeration or thread scheduling
+	std::ranges::sort(paths);
+
+	return paths;
+}
+
+bool LightManager::ReadConfigs()
+{
+	logger::info("{:*^50}", "CONFIG FILES");
+
+	LoadReport::ScopedTimer timer(LoadReport::GetSingleton()->readConfigsTime);
+
+	configPaths = GetConfigPaths();
+	if (configPaths.empty()) {
+		return false;
+	}
+
+	std::vector<std::string> buffers;
+	configHash = ConfigCache::HashConfigFiles(configPaths, buffers);
+
+	// the cache can only be validated against the load order once forms are loaded
+	if (ConfigCache::Header header; configHash && ConfigCache::ReadHeader(header) && header.configHash == *configHash) {
+		logger::info("Config cache matches {} files, deferring to data load", configPaths.size());
+		useConfigCache = true;
+		return true;
+	}
+
+	return ParseConfigs(std::move(buffers));
+}
+
+bool LightManager::ParseConfigs(std::vector<std::string> a_buffers)
+{
+	auto results = ParseConfigFiles(configPaths, std::move(a_buffers));
+
+	for (auto& result : results) {
+		logger::info("Read {}... ({} bytes, {:.2f} ms)", result.path.string(), result.bytes, result.parseTime);
+		if (result.error) {
+			logger::error("\terror:{}", *result.error);
 		} else {
-			logger::info("\t{} entries", tmpConfig.size());
-			configs.append_range(std::move(tmpConfig));
+			logger::info("\t{} entries", result.configs.size());
 		}
+		for (const auto& warning : result.warnings) {
+			logger::warn("\t{}", warning);
+		}
+		LoadReport::GetSingleton()->AddFile(result.path, result.bytes, result.configs.size(), result.parseTime, result.error);
+		configFiles.insert_or_assign(result.path, ConfigFileInfo(result.hash, result.configs));
+		configs.append_range(std::move(result.configs));
 	}
 
 	return !configs.empty();
 }
 
+std::vector<LightManager::ParseResult> LightManager::ParseConfigFiles(const std::vector<std::filesystem::path>& a_paths, std::vector<std::string> a_buffers)
+{
+	std::vector<ParseResult> results(a_paths.size());
+
+	const auto parse_file = [&](std::size_t a_index) {
+		auto& result = results[a_index];
+		result.path = a_paths[a_index];
+
+		const auto start = std::chrono::steady_clock::now();
+
+		std::string buffer;
+		if (a_index < a_buffers.size()) {
+			buffer = std::move(a_buffers[a_index]);
+		}
+
+		if (auto ec = buffer.empty() ? glz::file_to_buffer(buffer, result.path.string()) : glz::error_code::none; ec != glz::error_code::none) {
+			result.error = std::format("failed to read file ({})", glz::format_error(ec));
+		} else {
+			result.hash = HashConfigFile(buffer);
+			result.bytes = buffer.size();
+			if (auto err = glz::read_json(result.configs, buffer)) {
+				result.error = glz::format_error(err, buffer);
+				result.configs.clear();
+			} else {
+				result.warnings = Config::Validate(result.configs);
+			}
+		}
+
+		result.parseTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	const auto numThreads = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), MAX_PARSE_THREADS);
+	const auto numWorkers = std::min(numThreads, a_paths.size());
+
+	if (numWorkers <= 1) {
+		for (std::size_t i = 0; i < a_paths.size(); ++i) {
+			parse_file(i);
+		}
+		return results;
+	}
+
+	// workers pull the next unparsed file; each result slot is owned by exactly one worker
+	std::atomic<std::size_t> nextIndex{ 0 };
+	{
+		std::vector<std::jthread> workers;
+		workers.reserve(numWorkers);
+		for (std::size_t i = 0; i < numWorkers; ++i) {
+			workers.emplace_back([&]() {
+				for (auto index = nextIndex++; index < a_paths.size(); index = nextIndex++) {
+					parse_file(index);
+				}
+			});
+		}
+	}
+
+	return results;
+}
+
 void LightManager::OnDataLoad()
 {
-	if (configs.empty()) {
-		return;
+	if (!useConfigCache || !LoadConfigCache()) {
+		if (useConfigCache) {
+			logger::info("{:*^50}", "CONFIG FILES");
+			ParseConfigs();
+		}
+
+		if (configs.empty()) {
+			return;
+		}
+
+		LoadReport::GetSingleton()->memory.configs = Config::GetMemoryUsage(configs);
+
+		ProcessConfigs();
+
+		// unresolved definitions can't be cached
+		if (!Settings::GetSingleton()->ShouldLazyLoadLights()) {
+			WriteConfigCache();
+		}
+
+		// lights now live in lightDefinitions and reload tracks keys per file, so the parsed sets are dead weight
+		std::vector<Config::Format>().swap(configs);
 	}
 
-	ProcessConfigs();
+	BuildModelTable(gameModels, modelTable);
+	BuildScheduleTransitions();
 
 	logger::info("{:*^50}", "RESULTS");
 
 	logger::info("Models : {} entries", gameModels.size());
 	logger::info("VisualEffects : {} entries", gameVisualEffects.size());
+	ReportMemoryUsage();
+
+	LoadReport::GetSingleton()->Log();
+	LoadReport::GetSingleton()->Write();
 
 	RE::PlayerCharacter::GetSingleton()->AddEventSink<RE::BGSActorCellEvent>(GetSingleton());
 	RE::ScriptEventSourceHolder::GetSingleton()->AddEventSink<RE::TESWaitStopEvent>(GetSingleton());
 }
 
-void LightManager::ReloadConfigs()
+std::uint64_t LightManager::HashConfigFile(std::string_view a_buffer)
+{
+	return boost::hash<std::string_view>()(a_buffer);
+}
+
+LightManager::ConfigFileInfo::ConfigFileInfo(std::uint64_t a_hash, const std::vector<Config::Format>& a_configs) :
+	hash(a_hash)
+{
+	for (const auto& multiData : a_configs) {
+		std::visit(overload{
+					   [&](const Config::MultiModelSet& models) {
+						   this->models.insert(models.models.begin(), models.models.end());
+					   },
+					   [&](const Config::MultiVisualEffectSet& effects) {
+						   visualEffects.insert(effects.visualEffects.begin(), effects.visualEffects.end());
+					   },
+					   [&](const Config::MultiAddonSet&) {
+					   } },
+			multiData);
+	}
+}
+
+bool LightManager::ConfigFileInfo::Intersects(const StringSet& a_models, const StringSet& a_visualEffects) const
+{
+	return std::ranges::any_of(models, [&](const auto& model) { return a_models.contains(model); }) ||
+	       std::ranges::any_of(visualEffects, [&](const auto& effect) { return a_visualEffects.contains(effect); });
+}
+
+std::vector<RE::TESObjectREFRPtr> LightManager::ReloadConfigs()
 {
-	ReadConfigs(true);
+	logger::info("{:*^50}", "RELOAD");
+
+	const auto paths = GetConfigPaths();
+
+	// only files whose contents changed are parsed up front, from the buffer already read for hashing
+	std::map<std::filesystem::path, ConfigFileInfo> newConfigFiles;
+	std::vector<std::filesystem::path>              changedPaths;
+	std::vector<std::string>                        changedBuffers;
+
+	for (const auto& path : paths) {
+		std::string buffer;
+		if (glz::file_to_buffer(buffer, path.string()) != glz::error_code::none) {
+			continue;
+		}
+		if (const auto it = configFiles.find(path); it != configFiles.end() && it->second.hash == HashConfigFile(buffer)) {
+			newConfigFiles.emplace(path, it->second);
+		} else {
+			changedPaths.push_back(path);
+			changedBuffers.push_back(std::move(buffer));
+		}
+	}
+
+	StringSet           affectedModels;
+	StringSet           affectedEffects;
+	FlatSet<RE::FormID> affectedEffectIDs;
+
+	const auto add_affected_keys = [&](const ConfigFileInfo& a_info) {
+		affectedModels.insert(a_info.models.begin(), a_info.models.end());
+		affectedEffects.insert(a_info.visualEffects.begin(), a_info.visualEffects.end());
+	};
+
+	for (const auto& [path, info] : configFiles) {
+		if (!newConfigFiles.contains(path)) {  // changed or removed
+			add_affected_keys(info);
+		}
+	}
+
+	// loaded from the binary cache, so per-file contents are unknown
+	if (configFiles.empty()) {
+		for (const auto& [model, indices] : gameModels) {
+			affectedModels.emplace(model);
+		}
+		for (const auto& [formID, indices] : gameVisualEffects) {
+			affectedEffectIDs.emplace(formID);
+		}
+	}
+
+	if (changedPaths.empty() && affectedModels.empty() && affectedEffects.empty() && affectedEffectIDs.empty()) {
+		logger::info("No config changes found");
+		return {};
+	}
+
+	std::map<std::filesystem::path, std::vector<Config::Format>> parsedConfigs;
+
+	// only changed files widen the affected keys. an unchanged file still holds the lights it had for its other keys,
+	// so rebuilding those keys from it would drop lights that other unparsed files contribute
+	const auto parse_files = [&](const std::vector<std::filesystem::path>& a_paths, std::vector<std::string> a_buffers, bool a_changed) {
+		for (auto& result : ParseConfigFiles(a_paths, std::move(a_buffers))) {
+			logger::info("Reloaded {}... ({:.2f} ms)", result.path.string(), result.parseTime);
+			if (result.error) {
+				logger::error("\terror:{}", *result.error);
+			}
+			for (const auto& warning : result.warnings) {
+				logger::warn("\t{}", warning);
+			}
+			ConfigFileInfo info(result.hash, result.configs);
+			if (a_changed) {
+				add_affected_keys(info);
+			}
+			newConfigFiles.insert_or_assign(result.path, std::move(info));
+			parsedConfigs.emplace(result.path, std::move(result.configs));
+		}
+	};
 
-	if (configs.empty()) {
+	parse_files(changedPaths, std::move(changedBuffers), true);
+
+	// unchanged files that share a key with a changed file are needed to rebuild that key in order
+	std::vector<std::filesystem::path> dependentPaths;
+	for (const auto& [path, info] : newConfigFiles) {
+		if (!parsedConfigs.contains(path) && (configFiles.empty() || info.Intersects(affectedModels, affectedEffects))) {
+			dependentPaths.push_back(path);
+		}
+	}
+	parse_files(dependentPaths, {}, false);
+
+	for (const auto& effect : affectedEffects) {
+		if (auto formID = RE::GetFormID(effect); formID != 0) {
+			affectedEffectIDs.emplace(formID);
+		}
+	}
+
+	// attach hooks keep reading the current tables while the new ones are built from a copy
+	LightTables tables{ .models = gameModels, .visualEffects = gameVisualEffects };
+	{
+		std::scoped_lock lock(lazyLoadLock);  // a first attach may be resolving one of them
+		tables.definitions = lightDefinitions;
+		tables.states.reserve(lightStates.size());
+		for (const auto& state : lightStates) {
+			tables.states.emplace_back(state.value.load(std::memory_order_relaxed));
+		}
+	}
+
+	for (const auto& model : affectedModels) {
+		tables.models.erase(model);
+	}
+	for (const auto& formID : affectedEffectIDs) {
+		tables.visualEffects.erase(formID);
+	}
+
+	for (auto& [path, fileConfigs] : parsedConfigs) {
+		for (auto& multiData : fileConfigs) {
+			std::visit(overload{
+						   [&](Config::MultiModelSet& models) {
+							   if (std::ranges::none_of(models.models, [&](const auto& str) { return affectedModels.contains(str); })) {
+								   return;
+							   }
+							   PostProcess(models.lights);
+							   const auto indices = AddLightDefinitions(models.lights, tables.definitions, tables.states);
+							   for (auto& str : models.models) {
+								   if (affectedModels.contains(str)) {
+									   tables.models[str].append_range(indices);
+								   }
+							   }
+						   },
+						   [&](Config::MultiVisualEffectSet& visualEffects) {
+							   FlatSet<RE::FormID> formIDs;
+							   for (auto& rawID : visualEffects.visualEffects) {
+								   if (auto formID = RE::GetFormID(rawID); formID != 0 && affectedEffectIDs.contains(formID)) {
+									   formIDs.emplace(formID);
+								   }
+							   }
+							   if (formIDs.empty()) {
+								   return;
+							   }
+							   PostProcess(visualEffects.lights);
+							   const auto indices = AddLightDefinitions(visualEffects.lights, tables.definitions, tables.states);
+							   for (const auto& formID : formIDs) {
+								   tables.visualEffects[formID].append_range(indices);
+							   }
+						   },
+						   [&](const Config::MultiAddonSet&) {
+						   } },
+				multiData);
+		}
+	}
+
+	configFiles = std::move(newConfigFiles);
+
+	CompactLightDefinitions(tables);
+
+	ModelTable newModelTable;
+	BuildModelTable(tables.models, newModelTable);
+
+	{
+		std::unique_lock lock(definitionsLock);
+		lightDefinitions = std::move(tables.definitions);
+		lightStates = std::move(tables.states);
+		gameModels = std::move(tables.models);
+		gameVisualEffects = std::move(tables.visualEffects);
+		modelTable = std::move(newModelTable);
+	}
+
+	BuildScheduleTransitions();
+
+	logger::info("{} files changed, {} models and {} visual effects rebuilt", changedPaths.size(), affectedModels.size(), affectedEffectIDs.size());
+
+	// worn, casting and effect lights don't record the model or effect they were built from, so they are dropped and come back on their next attach
+	DetachWornAndEffectLights();
+
+	std::vector<RE::TESObjectREFRPtr> refs;
+	for (auto& ref : GetLightAttachedRefs()) {
+		const auto base = ref->GetBaseObject();
+		const auto model = base ? base->As<RE::TESModel>() : nullptr;
+		if (model && affectedModels.contains(model->GetModel())) {
+			refs.push_back(std::move(ref));
+		}
+	}
+
+	return refs;
+}
+
+void LightManager::RelightReference(RE::TESObjectREFR* a_ref)
+{
+	const auto base = a_ref->GetBaseObject();
+	const auto root = a_ref->Get3D();
+	if (!base || !root) {
 		return;
 	}
 
-	gameModels.clear();
-	gameVisualEffects.clear();
+	auto& lightMap = a_ref->Is(RE::FormType::PlacedHazard) ? gameHazardLights : gameRefLights;
+	auto  handle = a_ref->CreateRefHandle().native_handle();
+
+	// keep the NiPointLights attached so lights with unchanged names are regenerated in place
+	std::vector<LightOutput> oldOutputs;
+	lightMap.erase_if(handle, [&](auto& map) {
+		map.second.RemoveLights(false);
+		for (const auto& light : map.second.lights) {
+			oldOutputs.push_back(light.output);
+		}
+		return true;
+	});
+
+	AddLights(a_ref, base, root);
 
-	ProcessConfigs();
+	lightMap.cvisit(handle, [&](auto& map) {
+		std::erase_if(oldOutputs, [&](const auto& output) {
+			return std::ranges::find(map.second.lights, output) != map.second.lights.end();
+		});
+	});
+
+	for (const auto& output : oldOutputs) {
+		output.HideDebugMarker();
+		if (output.niLight && output.niLight->parent) {
+			output.niLight->parent->DetachChild(output.niLight.get());
+		}
+	}
+
+	if (const auto cell = a_ref->GetParentCell(); cell && cell->loadedData) {
+		AddLightsToUpdateQueue(cell, a_ref);
+	}
+}
+
+bool LightManager::LoadConfigCache()
+{
+	const auto report = LoadReport::GetSingleton();
+	const auto start = std::chrono::steady_clock::now();
+
+	LoadReport::ScopedTimer timer(report->cacheLoadTime);
+
+	ConfigCache::Header header;
+	ConfigCache::Tables tables;
+
+	if (!configHash || !ConfigCache::Read(header, tables) || header.configHash != *configHash) {
+		logger::info("Config cache is invalid, reading config files");
+		return false;
+	}
+
+	if (header.loadOrderHash != ConfigCache::HashLoadOrder()) {
+		logger::info("Load order has changed, reading config files");
+		return false;
+	}
+
+	if (header.settingsHash != ConfigCache::HashSettings()) {
+		logger::info("Settings have changed, reading config files");
+		return false;
+	}
+
+	// cached indices are remapped, skipping lights whose forms no longer resolve
+	constexpr auto INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+	std::vector<std::uint32_t> remap(tables.lights.size(), INVALID_INDEX);
+	lightDefinitions.reserve(tables.lights.size());
+	for (const auto [index, entry] : std::views::enumerate(tables.lights)) {
+		if (auto light = ConfigCache::Unpack(entry)) {
+			remap[index] = static_cast<std::uint32_t>(lightDefinitions.size());
+			lightDefinitions.push_back(std::move(*light));
+			lightStates.emplace_back(LIGHT_STATE::kValid);
+		}
+	}
+
+	const auto remap_indices = [&](const std::vector<std::uint32_t>& a_indices, Config::LightSourceIndices& a_out) {
+		for (const auto index : a_indices) {
+			if (index < remap.size() && remap[index] != INVALID_INDEX) {
+				a_out.push_back(remap[index]);
+			}
+		}
+	};
+
+	for (const auto& [model, indices] : tables.models) {
+		remap_indices(indices, gameModels[model]);
+	}
+
+	for (const auto& [formID, indices] : tables.visualEffects) {
+		remap_indices(indices, gameVisualEffects[formID]);
+	}
+
+	report->usedConfigCache = true;
+
+	logger::info("{:*^50}", "CONFIG CACHE");
+	logger::info("Loaded {} lights from cache ({:.2f} ms)", lightDefinitions.size(), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+	return true;
+}
+
+void LightManager::WriteConfigCache() const
+{
+	// a config file that couldn't be read leaves nothing to validate the cache against
+	if (!configHash) {
+		logger::info("Config files could not all be read, not writing the config cache");
+		return;
+	}
+
+	ConfigCache::Header header;
+	header.configHash = *configHash;
+	header.loadOrderHash = ConfigCache::HashLoadOrder();
+	header.settingsHash = ConfigCache::HashSettings();
+
+	ConfigCache::Tables tables;
+
+	// definitions are already shared, so the cache indices mirror the runtime tables
+	tables.lights.reserve(lightDefinitions.size());
+	for (const auto& light : lightDefinitions) {
+		tables.lights.push_back(ConfigCache::Pack(light));
+	}
+
+	tables.models.reserve(gameModels.size());
+	for (const auto& [model, indices] : gameModels) {
+		tables.models.emplace_back(model, indices);
+	}
+
+	tables.visualEffects.reserve(gameVisualEffects.size());
+	for (const auto& [formID, indices] : gameVisualEffects) {
+		tables.visualEffects.emplace_back(formID, indices);
+	}
+
+	if (!ConfigCache::Write(header, tables)) {
+		logger::warn("Failed to write config cache");
+	}
 }
 
 void LightManager::ProcessConfigs()
 {
+	LoadReport::ScopedTimer timer(LoadReport::GetSingleton()->processConfigsTime);
+
+	// model lights are resolved on first attach instead; visual effects are keyed by resolved formIDs so they stay eager
+	const bool lazyLoad = Settings::GetSingleton()->ShouldLazyLoadLights();
+
 	for (auto& multiData : configs) {
 		std::visit(overload{
 					   [&](Config::MultiModelSet& models) {
-						   PostProcess(models.lights);
+						   if (!lazyLoad) {
+							   PostProcess(models.lights);
+						   }
+						   const auto indices = AddLightDefinitions(models.lights, lightDefinitions, lightStates, !lazyLoad);
 						   for (auto& str : models.models) {
-							   gameModels[str].append_range(models.lights);
+							   gameModels[str].append_range(indices);
 						   }
 					   },
 					   [&](Config::MultiVisualEffectSet& visualEffects) {
 						   PostProcess(visualEffects.lights);
+						   const auto indices = AddLightDefinitions(visualEffects.lights, lightDefinitions, lightStates);
 						   for (auto& rawID : visualEffects.visualEffects) {
 							   if (auto formID = RE::GetFormID(rawID); formID != 0) {
-								   gameVisualEffects[formID].append_range(visualEffects.lights);
+								   gameVisualEffects[formID].append_range(indices);
 							   }
 						   }
 					   },
@@ -90,6 +555,172 @@ void LightManager::ProcessConfigs()
 	}
 }
 
+Config::LightSourceIndices LightManager::AddLightDefinitions(Config::LightSourceVec& a_lights, std::vector<Config::LightSourceData>& a_definitions, std::vector<LightState>& a_states, bool a_postProcessed)
+{
+	Config::LightSourceIndices indices;
+	indices.reserve(a_lights.size());
+	for (auto& light : a_lights) {
+		indices.push_back(static_cast<std::uint32_t>(a_definitions.size()));
+		a_definitions.push_back(std::move(light));
+		a_states.emplace_back(a_postProcessed ? LIGHT_STATE::kValid : LIGHT_STATE::kPending);
+	}
+	a_lights.clear();
+	return indices;
+}
+
+void LightManager::CompactLightDefinitions(LightTables& a_tables)
+{
+	constexpr auto INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+	std::vector<std::uint32_t>           remap(a_tables.definitions.size(), INVALID_INDEX);
+	std::vector<Config::LightSourceData> compacted;
+	std::vector<LightState>              compactedStates;
+
+	const auto remap_indices = [&](Config::LightSourceIndices& a_indices) {
+		for (auto& index : a_indices) {
+			if (remap[index] == INVALID_INDEX) {
+				remap[index] = static_cast<std::uint32_t>(compacted.size());
+				compacted.push_back(std::move(a_tables.definitions[index]));
+				compactedStates.push_back(std::move(a_tables.states[index]));
+			}
+			index = remap[index];
+		}
+	};
+
+	for (auto& [model, indices] : a_tables.models) {
+		remap_indices(indices);
+	}
+	for (auto& [formID, indices] : a_tables.visualEffects) {
+		remap_indices(indices);
+	}
+
+	if (const auto removed = a_tables.definitions.size() - compacted.size(); removed > 0) {
+		logger::info("Released {} unused light definitions", removed);
+	}
+
+	a_tables.definitions = std::move(compacted);
+	a_tables.states = std::move(compactedStates);
+}
+
+bool LightManager::ResolveLightDefinition(std::uint32_t a_index)
+{
+	auto& state = lightStates[a_index].value;
+
+	if (const auto current = state.load(std::memory_order_acquire); current != LIGHT_STATE::kPending) {
+		return current == LIGHT_STATE::kValid;
+	}
+
+	// first attach of a lazily loaded light; form lookups and condition building are serialized
+	std::scoped_lock lock(lazyLoadLock);
+
+	if (const auto current = state.load(std::memory_order_relaxed); current != LIGHT_STATE::kPending) {
+		return current == LIGHT_STATE::kValid;
+	}
+
+	const bool valid = PostProcess(lightDefinitions[a_index]);
+	state.store(valid ? LIGHT_STATE::kValid : LIGHT_STATE::kInvalid, std::memory_order_release);
+
+	return valid;
+}
+
+void LightManager::ReportConditionStats() const
+{
+	const auto report = LoadReport::GetSingleton();
+
+	std::tie(report->conditions.lightHits, report->conditions.lightEvaluations) = REFR_LIGH::ConditionMemo::GetStats();
+	std::tie(report->conditions.globalHits, report->conditions.globalEvaluations) = globalConditions.GetStats();
+
+	report->LogConditions();
+	report->Write();
+}
+
+void LightManager::ReportMemoryUsage() const
+{
+	std::vector<std::size_t> lightSizes;
+	lightSizes.reserve(lightDefinitions.size());
+	for (const auto& light : lightDefinitions) {
+		lightSizes.push_back(Config::GetMemoryUsage(light));
+	}
+
+	auto& memory = LoadReport::GetSingleton()->memory;
+	memory.lightDefinitions = std::ranges::fold_left(lightSizes, lightDefinitions.capacity() * sizeof(Config::LightSourceData), std::plus{});
+
+	// what per-key copies of each definition would have cost, against one copy plus an index per reference
+	std::size_t sharedSize = memory.lightDefinitions;
+	std::size_t copiedSize = 0;
+	std::size_t references = 0;
+
+	const auto add_references = [&](const Config::LightSourceIndices& a_indices) {
+		for (const auto index : a_indices) {
+			copiedSize += lightSizes[index];
+		}
+		sharedSize += a_indices.capacity() * sizeof(std::uint32_t);
+		references += a_indices.size();
+		return a_indices.capacity() * sizeof(std::uint32_t);
+	};
+
+	memory.models = gameModels.bucket_count() * sizeof(decltype(gameModels)::value_type);
+	for (const auto& [model, indices] : gameModels) {
+		memory.models += add_references(indices) + (model.capacity() > std::string().capacity() ? model.capacity() + 1 : 0);
+	}
+
+	memory.visualEffects = gameVisualEffects.bucket_count() * sizeof(decltype(gameVisualEffects)::value_type);
+	for (const auto& [formID, indices] : gameVisualEffects) {
+		memory.visualEffects += add_references(indices);
+	}
+
+	logger::info("Lights : {} definitions, {} references ({} bytes saved)", lightDefinitions.size(), references, copiedSize > sharedSize ? copiedSize - sharedSize : 0);
+
+	// keyframes used to be copied into every attached light, now each instance only keeps a reference, its time and a cursor
+	std::size_t animatedLights = 0;
+	std::size_t sequenceSize = 0;
+	for (const auto& light : lightDefinitions) {
+		std::visit([&](const auto& filteredData) {
+			if (const auto size = Config::GetControllerMemoryUsage(filteredData.data.data); size > 0) {
+				sequenceSize += size;
+				animatedLights++;
+			}
+		},
+			light);
+	}
+
+	if (animatedLights > 0) {
+		memory.controllerSequences = sequenceSize;
+		memory.controllersPerLightBefore = sizeof(LightControllers) + sequenceSize / animatedLights;
+		memory.controllersPerLightAfter = sizeof(LightControllers);
+
+		logger::info("Controllers : {} animated definitions, {} bytes per light instance before sharing, {} bytes after", animatedLights, memory.controllersPerLightBefore, memory.controllersPerLightAfter);
+	}
+}
+
+void LightManager::BuildScheduleTransitions()
+{
+	std::vector<const LightSchedule*> schedules;
+	for (const auto& light : lightDefinitions) {
+		std::visit([&](const auto& filteredData) {
+			if (const auto& schedule = filteredData.data.data.data.schedule; !schedule.empty()) {
+				schedules.push_back(&schedule);
+			}
+		},
+			light);
+	}
+
+	scheduleClock.SetTransitions(schedules);
+
+	if (!schedules.empty()) {
+		logger::info("Scheduled lights : {} definitions, {} transition hours", schedules.size(), scheduleClock.transitions.size());
+	}
+}
+
+void LightManager::BuildModelTable(const StringMap<Config::LightSourceIndices>& a_models, ModelTable& a_table)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	a_table.Build(a_models);
+
+	logger::info("Built model table with {} entries ({:.2f} ms)", a_table.size(), std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+}
+
 std::vector<RE::TESObjectREFRPtr> LightManager::GetLightAttachedRefs()
 {
 	std::vector<RE::TESObjectREFRPtr> refs;
@@ -179,6 +810,28 @@ void LightManager::DetachExplosionLights(RE::Explosion* a_explosion)
 	});
 }
 
+void LightManager::DetachWornAndEffectLights()
+{
+	gameActorWornLights.erase_if([](auto& map) {
+		map.second.visit_all([](auto& nodeMap) {
+			nodeMap.second.RemoveLights(true);
+		});
+		return true;
+	});
+
+	gameActorMagicLights.erase_if([](auto& map) {
+		map.second.visit_all([](auto& srcMap) {
+			srcMap.second.RemoveLights(true);
+		});
+		return true;
+	});
+
+	gameVisualEffectLights.erase_if([](auto& map) {
+		map.second.RemoveLights(true);
+		return true;
+	});
+}
+
 void LightManager::AddWornLights(RE::TESObjectREFR* a_ref, const RE::BSTSmartPointer<RE::BipedAnim>& a_bipedAnim, std::int32_t a_slot, RE::NiAVObject* a_root)
 {
 	if (!a_ref || !a_root || a_slot == -1) {
@@ -325,21 +978,28 @@ void LightManager::AttachLightsImpl(const std::unique_ptr<SourceData>& a_srcData
 	std::vector<Config::PointData> collectedPoints{};
 	std::vector<Config::NodeData>  collectedNodes{};
 
-	if (!a_srcData->modelPath.empty()) {
-		if (auto it = gameModels.find(a_srcData->modelPath); it != gameModels.end()) {
-			if (srcAttachData->Initialize(a_srcData)) {
-				for (const auto& data : it->second) {
-					CollectValidLights(srcAttachData, data, collectedPoints, collectedNodes);
+	{
+		// lights are copied out, so the tables only need to stay put until a reload swaps them
+		std::shared_lock lock(definitionsLock);
+
+		if (!a_srcData->modelPath.empty()) {
+			if (const auto indices = modelTable.Find(a_srcData->modelPath)) {
+				if (srcAttachData->Initialize(a_srcData)) {
+					for (const auto index : *indices) {
+						if (ResolveLightDefinition(index)) {
+							CollectValidLights(srcAttachData, lightDefinitions[index], collectedPoints, collectedNodes);
+						}
+					}
 				}
 			}
 		}
-	}
 
-	if (a_formID != 0) {
-		if (auto it = gameVisualEffects.find(a_formID); it != gameVisualEffects.end()) {
-			if (srcAttachData->Initialize(a_srcData)) {
-				for (const auto& data : it->second) {
-					CollectValidLights(srcAttachData, data, collectedPoints, collectedNodes);
+		if (a_formID != 0) {
+			if (auto it = gameVisualEffects.find(a_formID); it != gameVisualEffects.end()) {
+				if (srcAttachData->Initialize(a_srcData)) {
+					for (const auto index : it->second) {
+						CollectValidLights(srcAttachData, lightDefinitions[index], collectedPoints, collectedNodes);
+					}
 				}
 			}
 		}
@@ -493,8 +1153,9 @@ RE::BSEventNotifyControl LightManager::ProcessEvent(const RE::BGSActorCellEvent*
 
 	const bool currentCellIsInterior = cell->IsInteriorCell();
 	if (lastCellWasInterior != currentCellIsInterior) {
+		const auto scheduleTime = UpdateScheduleClock();
 		ForEachValidLight([&](const auto& ref, const auto& nodeName, auto& processedLights) {
-			processedLights.UpdateConditions(ref, nodeName, ConditionUpdateFlags::CellTransition);
+			processedLights.UpdateConditions(ref, nodeName, ConditionUpdateFlags::CellTransition, scheduleTime);
 		});
 	}
 	lastCellWasInterior = currentCellIsInterior;
@@ -509,8 +1170,9 @@ RE::BSEventNotifyControl LightManager::ProcessEvent(const RE::BGSActorCellEvent*
 RE::BSEventNotifyControl LightManager::ProcessEvent(const RE::TESWaitStopEvent* a_event, RE::BSTEventSource<RE::TESWaitStopEvent>*)
 {
 	if (a_event) {
+		const auto scheduleTime = UpdateScheduleClock(true);
 		ForEachValidLight([&](const auto& ref, const auto& nodeName, auto& processedLights) {
-			processedLights.UpdateConditions(ref, nodeName, ConditionUpdateFlags::Waiting);
+			processedLights.UpdateConditions(ref, nodeName, ConditionUpdateFlags::Waiting, scheduleTime);
 		});
 	}
 
@@ -525,6 +1187,10 @@ void LightManager::UpdateLights(const RE::TESObjectCELL* a_cell)
 		ProcessedLights::UpdateParams params;
 		params.pcPos = pc->GetPosition();
 		params.delta = RE::BSTimer::GetSingleton()->delta;
+		params.inputs = UpdateConditionInputs();
+		params.globalConditions = UpdateGlobalConditions();
+		params.scheduleTime = UpdateScheduleClock();
+		params.animationClock = UpdateAnimationClock();
 
 		std::erase_if(map.second.updatingLights, [&](auto& handle) {
 			RE::TESObjectREFRPtr ref{};
@@ -547,6 +1213,33 @@ void LightManager::UpdateLights(const RE::TESObjectCELL* a_cell)
 	});
 }
 
+GlobalConditions* LightManager::UpdateGlobalConditions()
+{
+	// the performance counter is sampled once per frame, so it doubles as a frame id
+	globalConditions.Update(RE::BSTimer::GetSingleton()->lastPerformanceCount);
+	return &globalConditions;
+}
+
+ConditionInputs LightManager::UpdateConditionInputs()
+{
+	conditionInputs.Update(RE::BSTimer::GetSingleton()->lastPerformanceCount);
+	return conditionInputs.Get();
+}
+
+LightSchedule::Time LightManager::UpdateScheduleClock(bool a_force)
+{
+	// one game hour read per frame flips every scheduled light together
+	scheduleClock.Update(RE::BSTimer::GetSingleton()->lastPerformanceCount, a_force);
+	return scheduleClock.Get();
+}
+
+double LightManager::UpdateAnimationClock()
+{
+	const auto timer = RE::BSTimer::GetSingleton();
+	animationClock.Update(timer->lastPerformanceCount, timer->delta);
+	return animationClock.Get();
+}
+
 void LightManager::UpdateEmittance(const RE::TESObjectCELL* a_cell)
 {
 	lightsToBeUpdated.visit(a_cell->GetFormID(), [&](auto& map) {
@@ -601,6 +1294,10 @@ void LightManager::UpdateTempEffectLights(RE::ReferenceEffect* a_effect)
 		params.ref = ref.get();
 		params.pcPos = RE::PlayerCharacter::GetSingleton()->GetPosition();
 		params.delta = RE::BSTimer::GetSingleton()->delta;
+		params.inputs = UpdateConditionInputs();
+		params.globalConditions = UpdateGlobalConditions();
+		params.scheduleTime = UpdateScheduleClock();
+		params.animationClock = UpdateAnimationClock();
 		params.dimFactor = dimFactor;
 
 		map.second.UpdateLightsAndRef(params);
@@ -631,6 +1328,10 @@ void LightManager::UpdateCastingLights(RE::ActorMagicCaster* a_actorMagicCaster,
 		params.ref = actor;
 		params.pcPos = RE::PlayerCharacter::GetSingleton()->GetPosition();
 		params.delta = a_delta;
+		params.inputs = UpdateConditionInputs();
+		params.globalConditions = UpdateGlobalConditions();
+		params.scheduleTime = UpdateScheduleClock();
+		params.animationClock = UpdateAnimationClock();
 
 		map.second.visit(castingSrc, [&](auto& processedLights) {
 			processedLights.second.UpdateLightsAndRef(params);
@@ -647,6 +1348,10 @@ void LightManager::UpdateHazardLights(RE::Hazard* a_hazard)
 		params.ref = a_hazard;
 		params.pcPos = RE::PlayerCharacter::GetSingleton()->GetPosition();
 		params.delta = RE::BSTimer::GetSingleton()->delta;
+		params.inputs = UpdateConditionInputs();
+		params.globalConditions = UpdateGlobalConditions();
+		params.scheduleTime = UpdateScheduleClock();
+		params.animationClock = UpdateAnimationClock();
 
 		constexpr auto MAX_WAIT_TIME = 3.0f;
 		const float    dimFactor = a_hazard->flags.any(RE::Hazard::Flags::kShuttingDown) ?
@@ -667,6 +1372,10 @@ void LightManager::UpdateExplosionLights(RE::Explosion* a_explosion)
 		params.ref = a_explosion;
 		params.pcPos = RE::PlayerCharacter::GetSingleton()->GetPosition();
 		params.delta = RE::BSTimer::GetSingleton()->delta;
+		params.inputs = UpdateConditionInputs();
+		params.globalConditions = UpdateGlobalConditions();
+		params.scheduleTime = UpdateScheduleClock();
+		params.animationClock = UpdateAnimationClock();
 		map.second.UpdateLightsAndRef(params);
 	});
 }
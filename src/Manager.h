@@ -2,6 +2,7 @@
 
 #include "ConfigData.h"
 #include "LightData.h"
+#include "ModelTable.h"
 #include "ProcessedLights.h"
 
 struct SourceData;
@@ -12,13 +13,15 @@ class LightManager :
 	public RE::BSTEventSink<RE::TESWaitStopEvent>
 {
 public:
-	bool ReadConfigs(bool a_reload = false);
-	void OnDataLoad();
-	void ReloadConfigs();
+	bool                              ReadConfigs();
+	void                              OnDataLoad();
+	std::vector<RE::TESObjectREFRPtr> ReloadConfigs();  // returns lit refs whose models were rebuilt
+	void                              ReportConditionStats() const;
 
 	std::vector<RE::TESObjectREFRPtr> GetLightAttachedRefs();
 
 	void AddLights(RE::TESObjectREFR* a_ref, RE::TESBoundObject* a_base, RE::NiAVObject* a_root);
+	void RelightReference(RE::TESObjectREFR* a_ref);
 	void ReattachLights(RE::TESObjectREFR* a_ref, RE::TESBoundObject* a_base);
 	void DetachLights(RE::TESObjectREFR* a_ref, bool a_clearData);
 	void DetachHazardLights(RE::Hazard* a_hazard);
@@ -135,7 +138,76 @@ public:
 	}
 
 private:
-	void ProcessConfigs();
+	struct ParseResult
+	{
+		std::filesystem::path       path;
+		std::vector<Config::Format> configs;
+		std::optional<std::string>  error;
+		std::vector<std::string>    warnings;
+		std::uint64_t               hash{ 0 };
+		std::size_t                 bytes{ 0 };
+		double                      parseTime{ 0.0 };  // ms
+	};
+
+	// keys each file contributes to, so a reload only rebuilds what changed
+	struct ConfigFileInfo
+	{
+		ConfigFileInfo() = default;
+		ConfigFileInfo(std::uint64_t a_hash, const std::vector<Config::Format>& a_configs);
+
+		bool Intersects(const StringSet& a_models, const StringSet& a_visualEffects) const;
+
+		// members
+		std::uint64_t hash{ 0 };
+		StringSet     models;
+		StringSet     visualEffects;  // unresolved
+	};
+
+	enum class LIGHT_STATE : std::uint8_t
+	{
+		kPending,  // not post-processed yet (lazy loading)
+		kValid,
+		kInvalid
+	};
+
+	struct LightState
+	{
+		LightState(LIGHT_STATE a_state) :
+			value(a_state)
+		{}
+		LightState(LightState&& a_rhs) noexcept :
+			value(a_rhs.value.load(std::memory_order_relaxed))
+		{}
+
+		std::atomic<LIGHT_STATE> value;
+	};
+
+	// light definitions and the keys indexing them, built aside by a reload and swapped in under definitionsLock
+	struct LightTables
+	{
+		std::vector<Config::LightSourceData>            definitions;
+		std::vector<LightState>                         states;
+		StringMap<Config::LightSourceIndices>           models;
+		FlatMap<RE::FormID, Config::LightSourceIndices> visualEffects;
+	};
+
+	static std::vector<std::filesystem::path> GetConfigPaths();
+	static std::vector<ParseResult>           ParseConfigFiles(const std::vector<std::filesystem::path>& a_paths, std::vector<std::string> a_buffers = {});  // buffers already read, by path index
+	static std::uint64_t                      HashConfigFile(std::string_view a_buffer);
+
+	bool        ParseConfigs(std::vector<std::string> a_buffers = {});  // buffers already read, by config path index
+	void        ProcessConfigs();
+	static void BuildModelTable(const StringMap<Config::LightSourceIndices>& a_models, ModelTable& a_table);
+	void        BuildScheduleTransitions();
+
+	static Config::LightSourceIndices AddLightDefinitions(Config::LightSourceVec& a_lights, std::vector<Config::LightSourceData>& a_definitions, std::vector<LightState>& a_states, bool a_postProcessed = true);
+	static void                       CompactLightDefinitions(LightTables& a_tables);
+	bool                              ResolveLightDefinition(std::uint32_t a_index);
+	void                              ReportMemoryUsage() const;
+	void                              DetachWornAndEffectLights();
+
+	bool LoadConfigCache();
+	void WriteConfigCache() const;
 
 	RE::BSEventNotifyControl ProcessEvent(const RE::BGSActorCellEvent* a_event, RE::BSTEventSource<RE::BGSActorCellEvent>*) override;
 	RE::BSEventNotifyControl ProcessEvent(const RE::TESWaitStopEvent* a_event, RE::BSTEventSource<RE::TESWaitStopEvent>*) override;
@@ -145,10 +217,26 @@ private:
 
 	void AttachLight(const LIGH::LightSourceData& a_lightSource, const std::unique_ptr<SourceAttachData>& a_srcData, RE::NiNode* a_node, std::uint32_t a_index = 0);
 
+	GlobalConditions*       UpdateGlobalConditions();
+	ConditionInputs         UpdateConditionInputs();
+	LightSchedule::Time     UpdateScheduleClock(bool a_force = false);
+	double                  UpdateAnimationClock();
+
 	// members
-	std::vector<Config::Format>                 configs;
-	StringMap<Config::LightSourceVec>           gameModels;
-	FlatMap<RE::FormID, Config::LightSourceVec> gameVisualEffects;
+	static constexpr std::size_t MAX_PARSE_THREADS{ 8 };
+
+	std::vector<std::filesystem::path>              configPaths;
+	std::map<std::filesystem::path, ConfigFileInfo> configFiles;
+	std::optional<std::uint64_t>                    configHash{};  // nullopt if a file couldn't be read
+	bool                                            useConfigCache{ false };
+	std::vector<Config::Format>                     configs;
+	std::vector<Config::LightSourceData>            lightDefinitions;  // shared by every key that lists them
+	std::vector<LightState>                         lightStates;       // parallel to lightDefinitions
+	std::mutex                                      lazyLoadLock;
+	StringMap<Config::LightSourceIndices>           gameModels;
+	ModelTable                                      modelTable;  // frozen copy of gameModels for attach lookups
+	FlatMap<RE::FormID, Config::LightSourceIndices> gameVisualEffects;
+	std::shared_mutex                               definitionsLock;  // held shared by attach lookups, exclusive while a reload swaps the tables above
 
 	LockedMap<RE::RefHandle, ProcessedLights>                           gameRefLights;
 	LockedMap<RE::RefHandle, LockedMap<std::string, ProcessedLights>>   gameActorWornLights;     // nodeName (armor node on attach isn't same ptr on detach)
@@ -159,4 +247,8 @@ private:
 
 	LockedMap<RE::FormID, LightsToUpdate> lightsToBeUpdated;
 	std::optional<bool>                   lastCellWasInterior;
+	GlobalConditions                      globalConditions;
+	ConditionInputsClock                  conditionInputs;
+	LightSchedule::Clock                  scheduleClock;
+	AnimationClock                        animationClock;
 };
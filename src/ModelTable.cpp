@@ -0,0 +1,115 @@
+#include "ModelTable.h"
+
+namespace
+{
+	constexpr char to_lower(char a_ch)
+	{
+		return (a_ch >= 'A' && a_ch <= 'Z') ? static_cast<char>(a_ch + ('a' - 'A')) : a_ch;
+	}
+}
+
+std::uint64_t ModelTable::Hash(std::string_view a_path)
+{
+	// FNV-1a
+	std::uint64_t hash = 0xCBF29CE484222325;
+	for (const auto ch : a_path) {
+		hash ^= static_cast<std::uint8_t>(to_lower(ch));
+		hash *= 0x100000001B3;
+	}
+	return hash;
+}
+
+bool ModelTable::Equals(std::string_view a_lowerPath, std::string_view a_path)
+{
+	return a_lowerPath.size() == a_path.size() && std::ranges::equal(a_lowerPath, a_path, [](char a_lhs, char a_rhs) {
+		return a_lhs == to_lower(a_rhs);
+	});
+}
+
+// probes are derived from both halves of the hash (double hashing), the low bits alone also pick the slot
+void ModelTable::AddToFilter(std::uint64_t a_hash)
+{
+	const auto step = (a_hash >> 32) | 1;
+	for (std::uint32_t i = 0; i < FILTER_PROBES; ++i) {
+		const auto bit = (a_hash + i * step) & filterMask;
+		filter[bit >> 6] |= 1ull << (bit & 63);
+	}
+}
+
+bool ModelTable::MayContain(std::uint64_t a_hash) const
+{
+	const auto step = (a_hash >> 32) | 1;
+	for (std::uint32_t i = 0; i < FILTER_PROBES; ++i) {
+		const auto bit = (a_hash + i * step) & filterMask;
+		if ((filter[bit >> 6] & (1ull << (bit & 63))) == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void ModelTable::Build(const StringMap<Indices>& a_models)
+{
+	Clear();
+
+	entries.reserve(a_models.size());
+	for (const auto& [model, indices] : a_models) {
+		if (model.empty() || indices.empty()) {
+			continue;
+		}
+		auto& entry = entries.emplace_back(model, indices);
+		std::ranges::transform(entry.path, entry.path.begin(), to_lower);
+	}
+
+	const auto slotCount = std::bit_ceil(std::max<std::size_t>(entries.size() * 2, 16));
+	slots.resize(slotCount);
+	mask = slotCount - 1;
+
+	const auto filterBits = std::bit_ceil(std::max<std::size_t>(entries.size() * FILTER_BITS_PER_ENTRY, 64));
+	filter.resize(filterBits / 64);
+	filterMask = filterBits - 1;
+
+	for (std::size_t index = 0; index < entries.size(); ++index) {
+		const auto hash = Hash(entries[index].path);
+		AddToFilter(hash);
+		for (auto i = hash & mask;; i = (i + 1) & mask) {
+			if (auto& slot = slots[i]; slot.index == EMPTY) {
+				slot.hash = hash;
+				slot.index = static_cast<std::uint32_t>(index);
+				break;
+			}
+		}
+	}
+}
+
+void ModelTable::Clear()
+{
+	entries.clear();
+	slots.clear();
+	mask = 0;
+	filter.clear();
+	filterMask = 0;
+}
+
+const ModelTable::Indices* ModelTable::Find(std::string_view a_path) const
+{
+	if (entries.empty()) {
+		return nullptr;
+	}
+
+	// most models that load have no lights
+	const auto hash = Hash(a_path);
+	if (!MayContain(hash)) {
+		return nullptr;
+	}
+
+	for (auto i = hash & mask;; i = (i + 1) & mask) {
+		const auto& slot = slots[i];
+		if (slot.index == EMPTY) {
+			return nullptr;
+		}
+		if (slot.hash == hash && Equals(entries[slot.index].path, a_path)) {
+			return &entries[slot.index].indices;
+		}
+	}
+}
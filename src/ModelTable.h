@@ -0,0 +1,48 @@
+#pragma once
+
+// read-only model path -> light indices table, rebuilt from gameModels whenever it changes
+// paths are lowercased and hashed once at build time; lookups hash in a single pass and most misses stop at a bloom filter
+// indices are copied in rather than pointing into gameModels; a reload builds a new table and swaps it in under the manager's definitionsLock
+class ModelTable
+{
+public:
+	using Indices = std::vector<std::uint32_t>;  // Config::LightSourceIndices
+
+	void Build(const StringMap<Indices>& a_models);
+	void Clear();
+
+	const Indices* Find(std::string_view a_path) const;
+
+	std::size_t size() const { return entries.size(); }
+	bool        empty() const { return entries.empty(); }
+
+private:
+	struct Entry
+	{
+		std::string path;  // lowercase
+		Indices     indices;
+	};
+
+	struct Slot
+	{
+		std::uint64_t hash{ 0 };
+		std::uint32_t index{ EMPTY };
+	};
+
+	static std::uint64_t Hash(std::string_view a_path);
+	static bool          Equals(std::string_view a_lowerPath, std::string_view a_path);
+
+	void AddToFilter(std::uint64_t a_hash);
+	bool MayContain(std::uint64_t a_hash) const;
+
+	// members
+	static constexpr std::uint32_t EMPTY{ std::numeric_limits<std::uint32_t>::max() };
+	static constexpr std::size_t   FILTER_BITS_PER_ENTRY{ 16 };  // with three probes, under 0.5% of misses get past the filter
+	static constexpr std::uint32_t FILTER_PROBES{ 3 };
+
+	std::vector<Entry>         entries;
+	std::vector<Slot>          slots;  // power of two, at most half full
+	std::uint64_t              mask{ 0 };
+	std::vector<std::uint64_t> filter;  // bloom filter over the path hashes, power of two bits
+	std::uint64_t              filterMask{ 0 };
+};
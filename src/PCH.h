@@ -2,7 +2,12 @@
 
 #define NOMINMAX
 
+#include <bitset>
+#include <charconv>
+#include <expected>
+#include <fstream>
 #include <shared_mutex>
+#include <thread>
 
 #include "RE/Skyrim.h"
 #include "REX/REX/Singleton.h"
@@ -20,7 +25,6 @@
 #include <frozen/unordered_map.h>
 #include <glaze/glaze.hpp>
 #include <spdlog/sinks/basic_file_sink.h>
-#include <srell.hpp>
 #include <xbyak/xbyak.h>
 
 #define DLLEXPORT __declspec(dllexport)
@@ -83,12 +83,13 @@ bool ProcessedLights::UpdateTimer(float a_delta, float a_interval)
 	return false;
 }
 
-void ProcessedLights::UpdateConditions(RE::TESObjectREFR* a_ref, std::string_view a_nodeName, ConditionUpdateFlags a_flags)
+void ProcessedLights::UpdateConditions(RE::TESObjectREFR* a_ref, std::string_view a_nodeName, ConditionUpdateFlags a_flags, const LightSchedule::Time& a_scheduleTime)
 {
 	nodeVisHelper.Reset();
+	conditionMemo.Reset();
 
 	for (auto& lightData : lights) {
-		lightData.UpdateConditions(a_ref, nodeVisHelper, a_flags);
+		lightData.UpdateConditions(a_ref, nodeVisHelper, conditionMemo, a_flags, a_scheduleTime);
 	}
 
 	nodeVisHelper.UpdateNodeVisibility(a_ref, a_nodeName);
@@ -96,12 +97,12 @@ void ProcessedLights::UpdateConditions(RE::TESObjectREFR* a_ref, std::string_vie
 
 void ProcessedLights::UpdateLightsAndRef(const UpdateParams& a_params)
 {
-	auto conditionUpdateFlags = ConditionUpdateFlags::Skip;
-	if (firstLoad) {
-		conditionUpdateFlags = ConditionUpdateFlags::Forced;
-	} else if (UpdateTimer(a_params.delta, 1.0f)) {
-		conditionUpdateFlags = ConditionUpdateFlags::Normal;
-	}
+	// conditions are re-run when an input they depend on changes; inputs without a change signal fall back to the timer
+	const bool timerElapsed = UpdateTimer(a_params.delta, 1.0f);
+	const auto changedInputs = lastInputs.GetChanged(a_params.inputs);
+	lastInputs = a_params.inputs;
+
+	conditionMemo.Reset(a_params.globalConditions);
 
 	const bool  withinFlickerDistance = a_params.ref->GetPosition().GetSquaredDistance(a_params.pcPos) < 67108864.0f;  // 8192.0f * 8192.0f
 	const float scale = withinFlickerDistance ? a_params.ref->GetScale() : 1.0f;
@@ -113,11 +114,23 @@ void ProcessedLights::UpdateLightsAndRef(const UpdateParams& a_params)
 			continue;
 		}
 
-		lightData.UpdateConditions(a_params.ref, nodeVisHelper, conditionUpdateFlags);
+		auto conditionUpdateFlags = ConditionUpdateFlags::Skip;
+		if (firstLoad) {
+			conditionUpdateFlags = ConditionUpdateFlags::Forced;
+		} else if (a_params.scheduleTime.changed && !lightData.data.schedule.empty()) {
+			conditionUpdateFlags = ConditionUpdateFlags::Schedule;
+		} else if (lightData.ShouldPollConditions(changedInputs, timerElapsed)) {
+			conditionUpdateFlags = ConditionUpdateFlags::Normal;
+		}
 
-		if (!niLight->GetAppCulled() && withinFlickerDistance) {
-			lightData.UpdateAnimation(a_params.delta, scale);
-			lightData.UpdateVanillaFlickering();
+		lightData.UpdateConditions(a_params.ref, nodeVisHelper, conditionMemo, conditionUpdateFlags, a_params.scheduleTime);
+
+		if (!niLight->GetAppCulled()) {
+			if (withinFlickerDistance) {
+				lightData.UpdateAnimation(a_params.animationClock, scale);
+				lightData.UpdateVanillaFlickering();
+			}
+			lightData.UpdateScheduleFade(withinFlickerDistance);
 		}
 	}
 
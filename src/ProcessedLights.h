@@ -9,11 +9,15 @@ struct ProcessedLights
 
 	struct UpdateParams
 	{
-		RE::TESObjectREFR* ref;
-		RE::NiPoint3       pcPos;
-		float              delta;
-		std::string_view   nodeName{ ""sv };
-		float              dimFactor{ RE::NI_INFINITY };
+		RE::TESObjectREFR*      ref;
+		RE::NiPoint3            pcPos;
+		float                   delta;
+		double                  animationClock{ 0.0 };
+		std::string_view        nodeName{ ""sv };
+		float                   dimFactor{ RE::NI_INFINITY };
+		ConditionInputs         inputs{};  // sampled once per frame by the caller
+		GlobalConditions*       globalConditions{ nullptr };
+		LightSchedule::Time     scheduleTime{};
 	};
 
 	std::size_t size() const { return lights.size(); }
@@ -31,14 +35,16 @@ struct ProcessedLights
 	void RemoveLights(bool a_clearData) const;
 
 	bool UpdateTimer(float a_delta, float a_interval);
-	void UpdateConditions(RE::TESObjectREFR* a_ref, std::string_view a_nodeName, ConditionUpdateFlags a_flags);
+	void UpdateConditions(RE::TESObjectREFR* a_ref, std::string_view a_nodeName, ConditionUpdateFlags a_flags, const LightSchedule::Time& a_scheduleTime);
 	void UpdateLightsAndRef(const UpdateParams& a_params);
 	void UpdateEmittance() const;
 
 	// members
 	float                    lastUpdateTime{ 0.0f };
+	ConditionInputs          lastInputs{};
 	std::vector<REFR_LIGH>   lights;
 	REFR_LIGH::NodeVisHelper nodeVisHelper{};
+	REFR_LIGH::ConditionMemo conditionMemo{};
 	bool                     firstLoad{ true };
 };
 
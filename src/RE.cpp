@@ -1202,21 +1202,4 @@ namespace RE
 		static REL::Relocation<func_t> func{ RELOCATION_ID(17212, 17614) };
 		func(a_light, a_ptLight, a_ref, a_wantDimmer);
 	}
-
-	void WrapRotation(NiPoint3& a_rotation)
-	{
-		constexpr auto wrap_angle = [](float& angle) {
-			angle = RE::deg_to_rad(angle);
-			while (angle > RE::NI_TWO_PI) {
-				angle -= RE::NI_TWO_PI;
-			}
-			while (angle < 0) {
-				angle += RE::NI_TWO_PI;
-			}
-		};
-
-		wrap_angle(a_rotation.x);
-		wrap_angle(a_rotation.y);
-		wrap_angle(a_rotation.z);
-	}
 }
@@ -0,0 +1,107 @@
+#include "Rotation.h"
+
+namespace RE
+{
+	void WrapRotation(NiPoint3& a_rotation)
+	{
+		constexpr auto wrap_angle = [](float& angle) {
+			angle = RE::deg_to_rad(angle);
+			while (angle > RE::NI_TWO_PI) {
+				angle -= RE::NI_TWO_PI;
+			}
+			while (angle < 0) {
+				angle += RE::NI_TWO_PI;
+			}
+		};
+
+		wrap_angle(a_rotation.x);
+		wrap_angle(a_rotation.y);
+		wrap_angle(a_rotation.z);
+	}
+
+	NiQuaternion EulerToQuaternion(const NiPoint3& a_rotation)
+	{
+		// built through the same matrix the Euler path produced, so both agree on axis order
+		NiPoint3 radians = a_rotation;
+		WrapRotation(radians);
+
+		NiMatrix3 m;
+		m.SetEulerAnglesXYZ(radians.x, radians.y, radians.z);
+
+		NiQuaternion q;
+		if (const float trace = m.entry[0][0] + m.entry[1][1] + m.entry[2][2]; trace > 0.0f) {
+			const float s = std::sqrt(trace + 1.0f) * 2.0f;
+			q.w = 0.25f * s;
+			q.x = (m.entry[2][1] - m.entry[1][2]) / s;
+			q.y = (m.entry[0][2] - m.entry[2][0]) / s;
+			q.z = (m.entry[1][0] - m.entry[0][1]) / s;
+		} else if (m.entry[0][0] > m.entry[1][1] && m.entry[0][0] > m.entry[2][2]) {
+			const float s = std::sqrt(1.0f + m.entry[0][0] - m.entry[1][1] - m.entry[2][2]) * 2.0f;
+			q.w = (m.entry[2][1] - m.entry[1][2]) / s;
+			q.x = 0.25f * s;
+			q.y = (m.entry[0][1] + m.entry[1][0]) / s;
+			q.z = (m.entry[0][2] + m.entry[2][0]) / s;
+		} else if (m.entry[1][1] > m.entry[2][2]) {
+			const float s = std::sqrt(1.0f + m.entry[1][1] - m.entry[0][0] - m.entry[2][2]) * 2.0f;
+			q.w = (m.entry[0][2] - m.entry[2][0]) / s;
+			q.x = (m.entry[0][1] + m.entry[1][0]) / s;
+			q.y = 0.25f * s;
+			q.z = (m.entry[1][2] + m.entry[2][1]) / s;
+		} else {
+			const float s = std::sqrt(1.0f + m.entry[2][2] - m.entry[0][0] - m.entry[1][1]) * 2.0f;
+			q.w = (m.entry[1][0] - m.entry[0][1]) / s;
+			q.x = (m.entry[0][2] + m.entry[2][0]) / s;
+			q.y = (m.entry[1][2] + m.entry[2][1]) / s;
+			q.z = 0.25f * s;
+		}
+
+		return q;
+	}
+
+	NiQuaternion Slerp(const NiQuaternion& a_from, const NiQuaternion& a_to, float a_t)
+	{
+		// normalized lerp with a cubic correction of t (zeux.io, "Approximating slerp"), avoids acos/sin and stays within ~0.1 degrees of an exact slerp
+		const float cosTheta = a_from.w * a_to.w + a_from.x * a_to.x + a_from.y * a_to.y + a_from.z * a_to.z;
+		const float d = std::abs(cosTheta);
+
+		const float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+		const float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+		const float k = A * (a_t - 0.5f) * (a_t - 0.5f) + B;
+		const float t = a_t + a_t * (a_t - 0.5f) * (a_t - 1.0f) * k;
+
+		const float fromWeight = 1.0f - t;
+		const float toWeight = cosTheta < 0.0f ? -t : t;  // short arc
+
+		NiQuaternion q;
+		q.w = fromWeight * a_from.w + toWeight * a_to.w;
+		q.x = fromWeight * a_from.x + toWeight * a_to.x;
+		q.y = fromWeight * a_from.y + toWeight * a_to.y;
+		q.z = fromWeight * a_from.z + toWeight * a_to.z;
+
+		const float invLength = 1.0f / std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+		q.w *= invLength;
+		q.x *= invLength;
+		q.y *= invLength;
+		q.z *= invLength;
+
+		return q;
+	}
+
+	void SetRotation(NiMatrix3& a_matrix, const NiQuaternion& a_rotation)
+	{
+		const float w = a_rotation.w;
+		const float x = a_rotation.x;
+		const float y = a_rotation.y;
+		const float z = a_rotation.z;
+
+		a_matrix.entry[0][0] = 1.0f - 2.0f * (y * y + z * z);
+		a_matrix.entry[0][1] = 2.0f * (x * y - w * z);
+		a_matrix.entry[0][2] = 2.0f * (x * z + w * y);
+		a_matrix.entry[1][0] = 2.0f * (x * y + w * z);
+		a_matrix.entry[1][1] = 1.0f - 2.0f * (x * x + z * z);
+		a_matrix.entry[1][2] = 2.0f * (y * z - w * x);
+		a_matrix.entry[2][0] = 2.0f * (x * z - w * y);
+		a_matrix.entry[2][1] = 2.0f * (y * z + w * x);
+		a_matrix.entry[2][2] = 1.0f - 2.0f * (x * x + y * y);
+	}
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+// rotation controller math, kept free of game calls so the benchmarks can build it
+namespace RE
+{
+	void         WrapRotation(NiPoint3& a_rotation);                   // degrees to radians in [0, 2pi]
+	NiQuaternion EulerToQuaternion(const NiPoint3& a_rotation);        // degrees, same convention as WrapRotation + SetEulerAnglesXYZ
+	NiQuaternion Slerp(const NiQuaternion& a_from, const NiQuaternion& a_to, float a_t);
+	void         SetRotation(NiMatrix3& a_matrix, const NiQuaternion& a_rotation);
+}
@@ -1,4 +1,5 @@
 #include "Settings.h"
+#include "LoadReport.h"
 
 namespace SETTINGS
 {
@@ -6,6 +7,8 @@ namespace SETTINGS
 	{
 		logger::info("{:*^50}", "SETTINGS");
 
+		LoadReport::ScopedTimer timer(LoadReport::GetSingleton()->settingsTime);
+
 		ReadSettings(R"(Data\SKSE\Plugins\po3_LightPlacer.ini)");
 
 		std::filesystem::path dir{ R"(Data\LightPlacer)" };
@@ -24,6 +27,8 @@ namespace SETTINGS
 		logger::info("bDisableAllGameLights : {}", disableAllGameLights);
 		logger::info("fGlobalLightRadiusMult : {}", globalLightRadius);
 		logger::info("fGlobalLightFadeMult : {}", globalLightFade);
+		logger::info("bLazyLoadLights : {}", lazyLoadLights);
+		logger::info("bBakeLightControllers : {}", bakeControllers);
 		logger::info("LightBlackList : {} entries", blackListedLights.size());
 		logger::info("LightWhiteList : {} entries", whiteListedLights.size());
 
@@ -77,6 +82,16 @@ namespace SETTINGS
 		return globalLightRadius;
 	}
 
+	bool Cache::ShouldLazyLoadLights() const
+	{
+		return lazyLoadLights;
+	}
+
+	bool Cache::ShouldBakeControllers() const
+	{
+		return bakeControllers;
+	}
+
 	bool Cache::ShouldDisableLights() const
 	{
 		return disableAllGameLights || !blackListedLights.empty() || !blackListedLightsRefs.empty();
@@ -111,6 +126,14 @@ namespace SETTINGS
 			disableAllGameLights = ini.GetBoolValue("Settings", "bDisableAllGameLights", false);
 		}
 
+		if (!lazyLoadLights) {
+			lazyLoadLights = ini.GetBoolValue("Settings", "bLazyLoadLights", false);
+		}
+
+		if (!bakeControllers) {
+			bakeControllers = ini.GetBoolValue("Settings", "bBakeLightControllers", false);
+		}
+
 		globalLightFade = static_cast<float>(ini.GetDoubleValue("Settings", "fGlobalLightFadeMult", 1.0));
 		globalLightRadius = static_cast<float>(ini.GetDoubleValue("Settings", "fGlobalLightRadiusMult", 1.0));
 
@@ -22,6 +22,9 @@ namespace SETTINGS
 		float GetGlobalLightFade() const;
 		float GetGlobalLightRadius() const;
 
+		bool ShouldLazyLoadLights() const;
+		bool ShouldBakeControllers() const;
+
 		bool ShouldDisableLights() const;
 		bool GetGameLightDisabled(const RE::TESObjectREFR* a_ref, const RE::TESBoundObject* a_base) const;
 
@@ -32,6 +35,8 @@ namespace SETTINGS
 		bool  showDebugMarkers{ false };
 		bool  loadDebugMarkers{ false };
 		bool  disableAllGameLights{ false };
+		bool  lazyLoadLights{ false };
+		bool  bakeControllers{ false };
 		float globalLightFade{ 1.0f };
 		float globalLightRadius{ 1.0f };
 
@@ -27,6 +27,9 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 			Debug::Install();
 		}
 		break;
+	case SKSE::MessagingInterface::kSaveGame:
+		LightManager::GetSingleton()->ReportConditionStats();
+		break;
 	default:
 		break;
 	}
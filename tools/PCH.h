@@ -0,0 +1,34 @@
+#pragma once
+
+// the bench stand-ins already cover the condition tokenizer, this adds what the function table and the file walk need
+
+#include "../bench/PCH.h"
+
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+
+// frozen::unordered_map over a flat array. lookups are linear, the validator only does one per condition
+namespace frozen
+{
+	template <class Key, class Value, std::size_t N>
+	class unordered_map
+	{
+	public:
+		using value_type = std::pair<Key, Value>;
+		using const_iterator = typename std::array<value_type, N>::const_iterator;
+
+		constexpr unordered_map(std::initializer_list<value_type> a_items)
+		{
+			std::ranges::copy(a_items, items.begin());
+		}
+
+		constexpr const_iterator find(const Key& a_key) const { return std::ranges::find(items, a_key, &value_type::first); }
+		constexpr const_iterator end() const { return items.end(); }
+
+	private:
+		// members
+		std::array<value_type, N> items{};
+	};
+}
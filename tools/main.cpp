@@ -0,0 +1,334 @@
+#include "ConditionFunctions.h"
+
+// checks a Data/LightPlacer tree without the game: json syntax, and every condition string against the same
+// tokenizer and function table the plugin uses. forms aren't looked up, that needs a load order
+// usage: LightPlacerValidator <Data/LightPlacer>, problems are printed as path:line:column and the exit code is 1 if there are any
+
+namespace
+{
+	struct Problem
+	{
+		std::size_t line;
+		std::size_t column;
+		std::string message;
+	};
+
+	// just enough json to find the condition arrays. syntax errors stop the file, as they do in the plugin's reader
+	class Reader
+	{
+	public:
+		explicit Reader(std::string_view a_buffer) :
+			buffer(a_buffer)
+		{}
+
+		void Read()
+		{
+			SkipSpaces();
+			if (pos == buffer.size() || buffer[pos] != '[') {
+				Fail("expected an array of entries");
+				return;
+			}
+			if (ReadValue({}, 0)) {
+				SkipSpaces();
+				if (pos != buffer.size()) {
+					Fail("unexpected characters after the entries");
+				}
+			}
+		}
+
+		const std::vector<Problem>& GetProblems() const { return problems; }
+		std::size_t                 GetConditionCount() const { return conditionCount; }
+
+	private:
+		static constexpr std::size_t MAX_DEPTH{ 256 };
+
+		void Report(std::size_t a_pos, std::string a_message)
+		{
+			const auto before = buffer.substr(0, a_pos);
+			const auto lineStart = before.rfind('\n');
+			const auto line = static_cast<std::size_t>(std::ranges::count(before, '\n')) + 1;
+			const auto column = a_pos - (lineStart == std::string_view::npos ? 0 : lineStart + 1) + 1;
+
+			problems.emplace_back(line, column, std::move(a_message));
+		}
+
+		bool Fail(std::string_view a_message, std::optional<std::size_t> a_pos = std::nullopt)
+		{
+			Report(a_pos.value_or(pos), std::string(a_message));
+			return false;
+		}
+
+		void SkipSpaces()
+		{
+			while (pos < buffer.size() && (buffer[pos] == ' ' || buffer[pos] == '\t' || buffer[pos] == '\n' || buffer[pos] == '\r')) {
+				++pos;
+			}
+		}
+
+		bool Consume(char a_ch)
+		{
+			if (pos < buffer.size() && buffer[pos] == a_ch) {
+				++pos;
+				return true;
+			}
+			return false;
+		}
+
+		bool ReadValue(std::string_view a_key, std::size_t a_depth)
+		{
+			if (a_depth > MAX_DEPTH) {
+				return Fail("nested too deep");
+			}
+			if (pos == buffer.size()) {
+				return Fail("unexpected end of file");
+			}
+
+			switch (buffer[pos]) {
+			case '{':
+				return ReadObject(a_depth);
+			case '[':
+				return ReadArray(a_key, a_depth);
+			case '"':
+				{
+					std::string str;
+					return ReadString(str);
+				}
+			case 't':
+				return ReadLiteral("true"sv);
+			case 'f':
+				return ReadLiteral("false"sv);
+			case 'n':
+				return ReadLiteral("null"sv);
+			default:
+				return ReadNumber();
+			}
+		}
+
+		bool ReadObject(std::size_t a_depth)
+		{
+			++pos;  // {
+			SkipSpaces();
+			if (Consume('}')) {
+				return true;
+			}
+
+			while (true) {
+				SkipSpaces();
+				if (pos == buffer.size() || buffer[pos] != '"') {
+					return Fail("expected a key");
+				}
+				std::string key;
+				if (!ReadString(key)) {
+					return false;
+				}
+				SkipSpaces();
+				if (!Consume(':')) {
+					return Fail("expected ':'");
+				}
+				SkipSpaces();
+				if (!ReadValue(key, a_depth + 1)) {
+					return false;
+				}
+				SkipSpaces();
+				if (Consume('}')) {
+					return true;
+				}
+				if (!Consume(',')) {
+					return Fail("expected ',' or '}'");
+				}
+			}
+		}
+
+		bool ReadArray(std::string_view a_key, std::size_t a_depth)
+		{
+			++pos;  // [
+			SkipSpaces();
+			if (Consume(']')) {
+				return true;
+			}
+
+			const bool isConditions = a_key == "conditions"sv;
+			while (true) {
+				SkipSpaces();
+				if (!(isConditions ? ReadCondition() : ReadValue({}, a_depth + 1))) {
+					return false;
+				}
+				SkipSpaces();
+				if (Consume(']')) {
+					return true;
+				}
+				if (!Consume(',')) {
+					return Fail("expected ',' or ']'");
+				}
+			}
+		}
+
+		// same check and message as ConditionParser::ValidateCondition, a bad condition doesn't stop the file
+		bool ReadCondition()
+		{
+			const auto start = pos;
+			if (pos == buffer.size() || buffer[pos] != '"') {
+				return Fail("condition must be a string");
+			}
+			std::string condition;
+			if (!ReadString(condition)) {
+				return false;
+			}
+
+			++conditionCount;
+			if (const auto tokens = ConditionFunctions::Validate(condition); !tokens) {
+				Report(start, "condition \"" + condition + "\" (column " + std::to_string(tokens.error().column) + ": " + std::string(tokens.error().message) + ")");
+			}
+			return true;
+		}
+
+		bool ReadString(std::string& a_str)
+		{
+			const auto start = pos++;  // "
+			while (pos < buffer.size()) {
+				const char ch = buffer[pos++];
+				if (ch == '"') {
+					return true;
+				}
+				if (static_cast<unsigned char>(ch) < 0x20) {
+					return Fail("control character in string", pos - 1);
+				}
+				if (ch != '\\') {
+					a_str += ch;
+					continue;
+				}
+				if (pos == buffer.size()) {
+					break;
+				}
+				switch (buffer[pos++]) {
+				case '"':
+					a_str += '"';
+					break;
+				case '\\':
+					a_str += '\\';
+					break;
+				case '/':
+					a_str += '/';
+					break;
+				case 'b':
+					a_str += '\b';
+					break;
+				case 'f':
+					a_str += '\f';
+					break;
+				case 'n':
+					a_str += '\n';
+					break;
+				case 'r':
+					a_str += '\r';
+					break;
+				case 't':
+					a_str += '\t';
+					break;
+				case 'u':
+					if (buffer.size() - pos < 4 || !std::ranges::all_of(buffer.substr(pos, 4), [](char a_ch) { return std::isxdigit(static_cast<unsigned char>(a_ch)) != 0; })) {
+						return Fail("invalid unicode escape", pos - 2);
+					}
+					pos += 4;
+					a_str += '?';  // condition strings are ascii, anything else fails the tokenizer either way
+					break;
+				default:
+					return Fail("invalid escape", pos - 2);
+				}
+			}
+			return Fail("unterminated string", start);
+		}
+
+		bool ReadLiteral(std::string_view a_literal)
+		{
+			if (!buffer.substr(pos).starts_with(a_literal)) {
+				return Fail("invalid value");
+			}
+			pos += a_literal.size();
+			return true;
+		}
+
+		bool ReadNumber()
+		{
+			constexpr auto is_number = [](char a_ch) { return (a_ch >= '0' && a_ch <= '9') || a_ch == '-' || a_ch == '+' || a_ch == '.' || a_ch == 'e' || a_ch == 'E'; };
+
+			const auto start = pos;
+			while (pos < buffer.size() && is_number(buffer[pos])) {
+				++pos;
+			}
+
+			double     value{};
+			const auto end = buffer.data() + pos;
+			if (const auto [ptr, ec] = std::from_chars(buffer.data() + start, end, value); start == pos || ec != std::errc{} || ptr != end) {
+				return Fail("invalid value", start);
+			}
+			return true;
+		}
+
+		// members
+		std::string_view     buffer;
+		std::size_t          pos{ 0 };
+		std::size_t          conditionCount{ 0 };
+		std::vector<Problem> problems;
+	};
+
+	// same walk and order as LightManager::GetConfigPaths
+	std::vector<std::filesystem::path> GetConfigPaths(const std::filesystem::path& a_dir)
+	{
+		std::vector<std::filesystem::path> paths;
+
+		for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(a_dir)) {
+			if (dirEntry.is_directory() || dirEntry.path().extension() != ".json"sv) {
+				continue;
+			}
+			paths.push_back(dirEntry.path());
+		}
+
+		std::ranges::sort(paths);
+
+		return paths;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	if (a_argc < 2) {
+		std::fprintf(stderr, "usage: LightPlacerValidator <Data/LightPlacer>\n");
+		return 2;
+	}
+
+	const std::filesystem::path dir{ a_argv[1] };
+	if (std::error_code ec; !std::filesystem::is_directory(dir, ec)) {
+		std::fprintf(stderr, "%s is not a directory\n", dir.string().c_str());
+		return 2;
+	}
+
+	std::size_t fileCount = 0;
+	std::size_t conditionCount = 0;
+	std::size_t problemCount = 0;
+
+	for (const auto& path : GetConfigPaths(dir)) {
+		++fileCount;
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			std::printf("%s: can't be read\n", path.string().c_str());
+			++problemCount;
+			continue;
+		}
+		const std::string buffer{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+		Reader reader(buffer);
+		reader.Read();
+
+		for (const auto& [line, column, message] : reader.GetProblems()) {
+			std::printf("%s:%zu:%zu: %s\n", path.string().c_str(), line, column, message.c_str());
+		}
+		conditionCount += reader.GetConditionCount();
+		problemCount += reader.GetProblems().size();
+	}
+
+	std::printf("%zu files, %zu conditions, %zu problems\n", fileCount, conditionCount, problemCount);
+
+	return problemCount > 0 ? 1 : 0;
+}